@@ -0,0 +1,84 @@
+# Build-time SPIR-V for every GLSL entry of res/kernels/vk/index.json.
+#
+# Each kernel is compiled with glslc and all binaries are written into one generated header,
+# tether_io_embedded_kernels.hpp, as constexpr u32 arrays. The Vulkan driver looks kernels up there
+# before touching the filesystem or shaderc, so with TETHER_IO_USE_SHADERC=OFF the executables neither
+# compile GLSL nor link shaderc.
+
+if(NOT TARGET_VULKAN_NATIVE OR NOT TETHER_IO_EMBED_SHADERS)
+    return()
+endif()
+
+find_program(TETHER_IO_GLSLC
+    NAMES glslc
+    HINTS "${Vulkan_GLSLC_EXECUTABLE}" "$ENV{VULKAN_SDK}/bin" "$ENV{VULKAN_SDK}/Bin"
+)
+
+if(NOT TETHER_IO_GLSLC)
+    message(WARNING "glslc not found, kernels are not embedded and are loaded or compiled at runtime")
+    return()
+endif()
+
+set(_kernel_dir "${RESOURCE_DIR}/kernels/vk")
+set(_gen_dir "${CMAKE_BINARY_DIR}/generated")
+set(_spv_dir "${_gen_dir}/spv")
+file(MAKE_DIRECTORY "${_spv_dir}")
+
+# Re-run configure when kernels are added to or removed from the index
+set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${_kernel_dir}/index.json")
+file(READ "${_kernel_dir}/index.json" _index)
+string(JSON _count LENGTH "${_index}" compute)
+
+set(_names)
+set(_spv_files)
+if(_count GREATER 0)
+    math(EXPR _last "${_count} - 1")
+    foreach(_i RANGE ${_last})
+        string(JSON _format GET "${_index}" compute ${_i} format)
+        if(NOT _format STREQUAL "glsl")
+            continue()
+        endif()
+
+        string(JSON _name  GET "${_index}" compute ${_i} name)
+        string(JSON _file  GET "${_index}" compute ${_i} file)
+        string(JSON _major GET "${_index}" compute ${_i} version 1)
+        string(JSON _minor GET "${_index}" compute ${_i} version 2)
+
+        set(_src "${_kernel_dir}/${_file}")
+        set(_spv "${_spv_dir}/${_name}.spv")
+
+        add_custom_command(
+            OUTPUT "${_spv}"
+            COMMAND "${TETHER_IO_GLSLC}" -fshader-stage=compute --target-env=vulkan${_major}.${_minor} -O -o "${_spv}" "${_src}"
+            DEPENDS "${_src}"
+            COMMENT "Compiling ${_file} to SPIR-V"
+            VERBATIM
+        )
+
+        list(APPEND _names "${_name}")
+        list(APPEND _spv_files "${_spv}")
+    endforeach()
+endif()
+
+if(NOT _names)
+    return()
+endif()
+
+# The list separator would split the arguments of the script call, pass the names comma separated
+list(JOIN _names "," _names_arg)
+set(_header "${_gen_dir}/tether_io_embedded_kernels.hpp")
+
+add_custom_command(
+    OUTPUT "${_header}"
+    COMMAND "${CMAKE_COMMAND}"
+        -DNAMES=${_names_arg}
+        -DSPV_DIR=${_spv_dir}
+        -DOUTPUT=${_header}
+        -P "${CMAKE_SOURCE_DIR}/cmake/EmbedSpirv.cmake"
+    DEPENDS ${_spv_files} "${CMAKE_SOURCE_DIR}/cmake/EmbedSpirv.cmake"
+    COMMENT "Embedding SPIR-V kernels"
+    VERBATIM
+)
+
+add_custom_target(tether_io_embedded_kernels DEPENDS "${_header}")
+set(TETHER_IO_EMBEDDED_KERNELS_DIR "${_gen_dir}")
@@ -0,0 +1,55 @@
+# Script mode (cmake -P): writes the SPIR-V binaries ${SPV_DIR}/<name>.spv for every name in the comma
+# separated NAMES as constexpr word arrays into the header OUTPUT.
+
+string(REPLACE "," ";" _names "${NAMES}")
+
+set(_body "")
+set(_table "")
+foreach(_name IN LISTS _names)
+    file(READ "${SPV_DIR}/${_name}.spv" _hex HEX)
+    string(LENGTH "${_hex}" _hex_len)
+    math(EXPR _rem "${_hex_len} % 8")
+    if(_hex_len EQUAL 0 OR NOT _rem EQUAL 0)
+        message(FATAL_ERROR "${SPV_DIR}/${_name}.spv is not a SPIR-V binary")
+    endif()
+
+    # SPIR-V is little-endian, every 4 bytes b0 b1 b2 b3 become the word 0xb3b2b1b0
+    string(REGEX MATCHALL "([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])" _bytes "${_hex}")
+    set(_words "")
+    set(_column 0)
+    foreach(_b IN LISTS _bytes)
+        string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1u," _word "${_b}")
+        if(_column EQUAL 0)
+            string(APPEND _words "\n    ")
+        else()
+            string(APPEND _words " ")
+        endif()
+        string(APPEND _words "${_word}")
+        math(EXPR _column "(${_column} + 1) % 8")
+    endforeach()
+
+    string(APPEND _body "inline constexpr u32 ${_name}[] = {${_words}\n};\n\n")
+    string(APPEND _table "    { \"${_name}\", ${_name} },\n")
+endforeach()
+
+set(_content "// Generated by cmake/EmbedSpirv.cmake from res/kernels/vk/index.json, do not edit.
+#pragma once
+
+#include <span>
+#include <string_view>
+
+#include <tether_io/types.hpp>
+
+namespace tether_io::embedded_kernels {
+
+${_body}struct entry {
+    std::string_view name;
+    std::span<const u32> words;
+};
+
+inline constexpr entry table[] = {
+${_table}};
+
+} // namespace tether_io::embedded_kernels
+")
+file(WRITE "${OUTPUT}" "${_content}")
@@ -7,10 +7,18 @@ foreach(_target IN LISTS TETHER_IO_TARGETS)
         target_link_libraries(${_target}
             PRIVATE
                 Vulkan::Vulkan
-                unofficial::shaderc::shaderc
         )
 
-        target_compile_definitions(${_target} PRIVATE USE_SHADERC=1)
+        if(TETHER_IO_USE_SHADERC)
+            target_link_libraries(${_target} PRIVATE unofficial::shaderc::shaderc)
+            target_compile_definitions(${_target} PRIVATE USE_SHADERC=1)
+        endif()
+
+        if(TARGET tether_io_embedded_kernels)
+            add_dependencies(${_target} tether_io_embedded_kernels)
+            target_include_directories(${_target} PRIVATE ${TETHER_IO_EMBEDDED_KERNELS_DIR})
+            target_compile_definitions(${_target} PRIVATE TETHER_IO_EMBEDDED_KERNELS=1)
+        endif()
     endif()
 
     target_link_libraries(${_target} PRIVATE nlohmann_json::nlohmann_json fmt::fmt)
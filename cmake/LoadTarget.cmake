@@ -6,6 +6,8 @@ if(ENABLE_LLAMA_CPP)
 endif()
 
 if(TARGET_VULKAN_NATIVE)
-    find_package(Vulkan REQUIRED)
-    find_package(unofficial-shaderc CONFIG REQUIRED)
+    find_package(Vulkan REQUIRED OPTIONAL_COMPONENTS glslc)
+    if(TETHER_IO_USE_SHADERC)
+        find_package(unofficial-shaderc CONFIG REQUIRED)
+    endif()
 endif()
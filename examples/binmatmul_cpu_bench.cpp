@@ -0,0 +1,129 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <tether_io/algorithm.hpp>
+
+// Compares the row-streaming binmatmul against the cache-blocked engine for square M = N shapes, then
+// measures how the tiled parallel kernel scales with the thread count on the largest shape.
+//
+//   example_binmatmul_cpu_bench [k_bits = 4096] [max_side = 8192]
+//
+// GOPS counts one XNOR and one popcount-add per bit: 2 * M * N * K_bits operations.
+
+int main(int argc, char** argv) {
+    using namespace tether_io;
+
+    const u32 K_bits   = (argc > 1) ? static_cast<u32>(std::stoul(argv[1])) : 4096u;
+    const u32 max_side = (argc > 2) ? static_cast<u32>(std::stoul(argv[2])) : 8192u;
+    const u32 K_words  = (K_bits + 31u) / 32u;
+
+    algorithm<device_driver::cpu_native, execution_method::standalone> host_kernel_launcher;
+    const cpu_isa isa = best_cpu_isa();
+    const cpu_gemm_blocking blocking{};
+
+    std::cout << "isa=" << to_string(isa)
+              << " K_bits=" << K_bits
+              << " blocking(mc=" << blocking.mc << ", nc=" << blocking.nc << ", kc=" << blocking.kc << ")\n";
+    std::cout << std::setw(8) << "M=N"
+              << std::setw(14) << "rows GOPS"
+              << std::setw(14) << "blocked GOPS"
+              << std::setw(10) << "speedup"
+              << std::setw(8) << "match" << "\n";
+
+    for (u32 side = 256u; side <= max_side; side *= 2u) {
+        // Packed operands are generated directly, the f32 path would need 32x the memory
+        auto A_res = host_kernel_launcher.random_mat_packed_u32(data_domain::pm_one, matrix_order::row_major, side, K_bits, 1234u);
+        auto B_res = host_kernel_launcher.random_mat_packed_u32(data_domain::pm_one, matrix_order::col_major, side, K_bits, 4321u);
+        if (!A_res.has_value() || !B_res.has_value()) {
+            std::cout << "could not generate operands for side=" << side << "\n";
+            return -1;
+        }
+        const std::vector<u32> A_bits = std::move(A_res.value());
+        const std::vector<u32> B_bits = std::move(B_res.value());
+
+        auto time_it = [](auto&& fn) {
+            auto t0 = std::chrono::steady_clock::now();
+            auto res = fn();
+            auto t1 = std::chrono::steady_clock::now();
+            return std::make_pair(std::move(res), std::chrono::duration<f64>(t1 - t0).count());
+        };
+
+        auto [rows_res, rows_s] = time_it([&] {
+            return host_kernel_launcher.binmatmul(A_bits, B_bits, side, side, K_bits, isa);
+        });
+        auto [blocked_res, blocked_s] = time_it([&] {
+            return host_kernel_launcher.binmatmul_blocked(A_bits, B_bits, side, side, K_bits, blocking, isa);
+        });
+
+        if (!rows_res.has_value() || !blocked_res.has_value()) {
+            std::cout << "binmatmul failed for side=" << side << "\n";
+            return -1;
+        }
+
+        const f64 ops = 2.0 * side * side * static_cast<f64>(K_bits);
+        const f64 rows_gops = ops / rows_s * 1e-9;
+        const f64 blocked_gops = ops / blocked_s * 1e-9;
+        const bool match = rows_res.value() == blocked_res.value();
+
+        std::cout << std::setw(8) << side
+                  << std::setw(14) << std::fixed << std::setprecision(1) << rows_gops
+                  << std::setw(14) << blocked_gops
+                  << std::setw(9) << std::setprecision(2) << blocked_gops / rows_gops << "x"
+                  << std::setw(8) << (match ? "yes" : "NO") << "\n";
+
+        if (!match) return -1;
+    }
+
+    // Thread scaling, 1, 2, 4, ... up to the hardware thread count (which is always included)
+    const u32 side = max_side;
+    std::vector<u32> A_bits(static_cast<usize>(side) * K_words);
+    std::vector<u32> B_bits(static_cast<usize>(side) * K_words);
+    if (!host_kernel_launcher.random_mat_packed_u32(data_domain::pm_one, matrix_order::row_major, A_bits, side, K_bits, 1234u).has_value() ||
+        !host_kernel_launcher.random_mat_packed_u32(data_domain::pm_one, matrix_order::col_major, B_bits, side, K_bits, 4321u).has_value()) {
+        std::cout << "could not generate operands for side=" << side << "\n";
+        return -1;
+    }
+
+    const usize hw_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<usize> thread_counts;
+    for (usize t = 1; t < hw_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(hw_threads);
+
+    std::cout << "\nthread scaling M=N=" << side << "\n";
+    std::cout << std::setw(8) << "threads"
+              << std::setw(14) << "GOPS"
+              << std::setw(10) << "speedup"
+              << std::setw(12) << "efficiency" << "\n";
+
+    f64 single_gops = 0.0;
+    for (auto threads : thread_counts) {
+        host_kernel_launcher.set_thread_count(threads);
+
+        // Warm-up spawns the pool so thread creation is not timed
+        const std::span<const u32> a_row = std::span<const u32>(A_bits).first(K_words);
+        const std::span<const u32> b_row = std::span<const u32>(B_bits).first(K_words);
+        if (!host_kernel_launcher.binmatmul_parallel(a_row, b_row, 1u, 1u, K_bits).has_value()) return -1;
+
+        auto t0 = std::chrono::steady_clock::now();
+        auto res = host_kernel_launcher.binmatmul_parallel(A_bits, B_bits, side, side, K_bits, {128u, 32u}, isa);
+        auto t1 = std::chrono::steady_clock::now();
+
+        if (!res.has_value()) {
+            std::cout << "binmatmul_parallel failed for threads=" << threads << "\n";
+            return -1;
+        }
+
+        const f64 gops = 2.0 * side * side * static_cast<f64>(K_bits) / std::chrono::duration<f64>(t1 - t0).count() * 1e-9;
+        if (threads == 1) single_gops = gops;
+
+        std::cout << std::setw(8) << threads
+                  << std::setw(14) << std::fixed << std::setprecision(1) << gops
+                  << std::setw(9) << std::setprecision(2) << gops / single_gops << "x"
+                  << std::setw(11) << std::setprecision(0) << 100.0 * gops / single_gops / static_cast<f64>(threads) << "%\n";
+    }
+
+    return 0;
+}
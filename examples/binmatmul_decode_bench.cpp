@@ -0,0 +1,256 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <tether_io/config.hpp>
+#include <tether_io/context.hpp>
+#include <tether_io/algorithm.hpp>
+
+// Single-token decode throughput of a binarized transformer block stack: every token runs the seven
+// projections of each layer with M = 1, which is the shape llama_vulkan_binmm_adapter sees while
+// generating. The 2D tiled kernels (the path decode used before) are compared against the GEMV ones,
+// on Vulkan also against the subgroup kernel. The async, sequence and graph rows go through the automatic
+// binmatmul, which keeps M = 1 on the GEMV kernel.
+//
+//   example_binmatmul_decode_bench [layers = 4] [tokens = 8]
+//
+// Shapes follow a 7B-class model: hidden 4096, feed-forward 11008.
+
+namespace {
+
+struct projection {
+    const char* name;
+    tether_io::u32 n;      // output features, rows of the weight matrix
+    tether_io::u32 k_bits; // input features
+};
+
+constexpr projection block[] = {
+    { "q",    4096u,  4096u },
+    { "k",    4096u,  4096u },
+    { "v",    4096u,  4096u },
+    { "o",    4096u,  4096u },
+    { "gate", 11008u, 4096u },
+    { "up",   11008u, 4096u },
+    { "down", 4096u,  11008u },
+};
+
+auto print_row(const char* backend, const char* path, tether_io::f64 seconds, tether_io::u32 tokens, tether_io::f64 baseline) -> void {
+    const tether_io::f64 tok_s = tokens / seconds;
+    std::cout << std::setw(8) << backend
+              << std::setw(15) << path
+              << std::setw(14) << std::fixed << std::setprecision(1) << tok_s
+              << std::setw(14) << std::setprecision(3) << seconds * 1e3 / tokens;
+    if (baseline > 0.0) std::cout << std::setw(9) << std::setprecision(2) << tok_s / baseline << "x";
+    std::cout << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using namespace tether_io;
+
+    const u32 layers = (argc > 1) ? static_cast<u32>(std::stoul(argv[1])) : 4u;
+    const u32 tokens = (argc > 2) ? static_cast<u32>(std::stoul(argv[2])) : 8u;
+
+    algorithm<device_driver::cpu_native, execution_method::standalone> host_kernel_launcher;
+    const cpu_isa isa = best_cpu_isa();
+
+    // One activation row and one weight matrix per projection, shared by all layers (same shapes, same cost)
+    std::vector<std::vector<u32>> act_bits;
+    std::vector<std::vector<u32>> wt_bits;
+    std::vector<std::vector<i32>> out;
+    u32 seed = 1u;
+    for (const auto& p : block) {
+        auto act = host_kernel_launcher.random_mat_packed_u32(data_domain::pm_one, matrix_order::row_major, 1u, p.k_bits, seed++);
+        auto wt  = host_kernel_launcher.random_mat_packed_u32(data_domain::pm_one, matrix_order::col_major, p.n, p.k_bits, seed++);
+        if (!act.has_value() || !wt.has_value()) {
+            std::cout << "could not generate operands for " << p.name << "\n";
+            return -1;
+        }
+        act_bits.push_back(std::move(act.value()));
+        wt_bits.push_back(std::move(wt.value()));
+        out.emplace_back(p.n);
+    }
+
+    std::cout << "isa=" << to_string(isa)
+              << " threads=" << host_kernel_launcher.thread_pool().thread_count()
+              << " layers=" << layers << " tokens=" << tokens << "\n";
+    std::cout << std::setw(8) << "backend"
+              << std::setw(15) << "path"
+              << std::setw(14) << "tokens/s"
+              << std::setw(14) << "ms/token"
+              << std::setw(10) << "speedup" << "\n";
+
+    auto time_tokens = [&](auto&& step) -> f64 {
+        if (!step()) return -1.0; // warm-up
+        auto t0 = std::chrono::steady_clock::now();
+        for (u32 t = 0; t < tokens; ++t) {
+            for (u32 l = 0; l < layers; ++l) {
+                if (!step()) return -1.0;
+            }
+        }
+        return std::chrono::duration<f64>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    // CPU: tiled parallel engine vs GEMV, both on the same pool
+    const f64 cpu_tiled = time_tokens([&] {
+        for (usize i = 0; i < std::size(block); ++i) {
+            auto res = binmatmul_parallel_cpu_native_standalone(
+                host_kernel_launcher.thread_pool(), act_bits[i], wt_bits[i], out[i], 1u, block[i].n, block[i].k_bits, {128u, 32u}, isa);
+            if (!res.has_value()) return false;
+        }
+        return true;
+    });
+    const f64 cpu_gemv = time_tokens([&] {
+        for (usize i = 0; i < std::size(block); ++i) {
+            if (!host_kernel_launcher.binmatmul_gemv(act_bits[i], wt_bits[i], out[i], 1u, block[i].n, block[i].k_bits, isa).has_value()) return false;
+        }
+        return true;
+    });
+    if (cpu_tiled < 0.0 || cpu_gemv < 0.0) {
+        std::cout << "cpu decode step failed\n";
+        return -1;
+    }
+    print_row("cpu", "tiled", cpu_tiled, tokens, 0.0);
+    print_row("cpu", "gemv", cpu_gemv, tokens, tokens / cpu_tiled);
+
+#ifdef TARGET_VULKAN_NATIVE
+    std::filesystem::path rsc = RESOURCE_DIR;
+    auto config = parse_application_settings(rsc / "settings.json");
+    if (!config.has_value()) {
+        std::cout << config.error() << std::endl;
+        return -1;
+    }
+
+    compute_context<device_driver::vulkan_native> ctx;
+    auto res = ctx.init(version<u32>{0, 1, 3, 0}, "binmatmul_decode_bench");
+    if (res.has_value()) res = ctx.set_device(device_select::first_compute_capable);
+    if (!res.has_value()) {
+        std::cout << res.error() << std::endl;
+        return -1;
+    }
+
+    auto limits = ctx.limits();
+    if (!limits.has_value()) {
+        ctx.exit();
+        std::cout << limits.error() << std::endl;
+        return -1;
+    }
+    const auto max_local = limits.value().max_compute_work_group_size;
+
+    std::vector<device_buffer<device_driver::vulkan_native>> d_act, d_wt, d_out;
+    for (usize i = 0; i < std::size(block); ++i) {
+        auto a = ctx.allocate(act_bits[i].size() * sizeof(u32), alloc_method::base);
+        auto w = ctx.allocate(wt_bits[i].size() * sizeof(u32), alloc_method::device_local);
+        auto c = ctx.allocate(out[i].size() * sizeof(i32), alloc_method::base);
+        if (!a.has_value() || !w.has_value() || !c.has_value()) {
+            ctx.exit();
+            std::cout << "device allocation failed\n";
+            return -1;
+        }
+        d_act.push_back(a.value());
+        d_wt.push_back(w.value());
+        d_out.push_back(c.value());
+
+        // Weights go through the transfer queue, each projection's first launch waits only for its own copy
+        if (!ctx.upload(d_act[i], std::span<u32>{act_bits[i]}, upload_method::sync).has_value() ||
+            !ctx.upload(d_wt[i], std::span<u32>{wt_bits[i]}, upload_method::async).has_value()) {
+            ctx.exit();
+            std::cout << "upload failed\n";
+            return -1;
+        }
+    }
+
+    algorithm<device_driver::vulkan_native, execution_method::sequenced> device_kernel_launcher(ctx, config.value());
+
+    // The 2D kernel the adapter used to launch for m = 1: one row of 16-wide workgroups
+    const f64 gpu_tiled = time_tokens([&] {
+        for (usize i = 0; i < std::size(block); ++i) {
+            const u32 k_words = (block[i].k_bits + 31u) / 32u;
+            const u32 local_x = std::min(16u, max_local.x);
+            auto r = device_kernel_launcher.binmatmul(
+                {(block[i].n + local_x - 1u) / local_x, 1u, 1u}, {local_x, 1u, 1u},
+                {d_act[i], d_wt[i], d_out[i]}, 1u, block[i].n, block[i].k_bits, k_words);
+            if (!r.has_value() || !ctx.wait_for_last_kernel(1'000'000'000ull).has_value()) return false;
+        }
+        return true;
+    });
+    const f64 gpu_gemv = time_tokens([&] {
+        for (usize i = 0; i < std::size(block); ++i) {
+            const u32 k_words = (block[i].k_bits + 31u) / 32u;
+            const auto launch = binmatmul_launch_geometry(max_local, 1u, block[i].n, k_words);
+            auto r = device_kernel_launcher.binmatmul_gemv(
+                launch.grid_size, launch.local_size, {d_act[i], d_wt[i], d_out[i]}, 1u, block[i].n, block[i].k_bits, k_words);
+            if (!r.has_value() || !ctx.wait_for_last_kernel(1'000'000'000ull).has_value()) return false;
+        }
+        return true;
+    });
+    // K split across a subgroup and reduced with subgroupAdd, only on devices with subgroup arithmetic
+    const u32 subgroup_size = limits.value().subgroup_size;
+    f64 gpu_subgroup = 0.0;
+    if (limits.value().subgroup.arithmetic && subgroup_size != 0) {
+        gpu_subgroup = time_tokens([&] {
+            for (usize i = 0; i < std::size(block); ++i) {
+                const u32 k_words = (block[i].k_bits + 31u) / 32u;
+                const auto launch = binmatmul_subgroup_launch_geometry(max_local, subgroup_size, 1u, block[i].n);
+                auto r = device_kernel_launcher.binmatmul_subgroup(
+                    launch.grid_size, launch.local_size, subgroup_size, {d_act[i], d_wt[i], d_out[i]}, 1u, block[i].n, block[i].k_bits, k_words);
+                if (!r.has_value() || !ctx.wait_for_last_kernel(1'000'000'000ull).has_value()) return false;
+            }
+            return true;
+        });
+    }
+    // All projections in flight at once, one wait per token instead of one per launch
+    const f64 gpu_gemv_async = time_tokens([&] {
+        for (usize i = 0; i < std::size(block); ++i) {
+            const u32 k_words = (block[i].k_bits + 31u) / 32u;
+            auto r = device_kernel_launcher.binmatmul({d_act[i], d_wt[i], d_out[i]}, 1u, block[i].n, block[i].k_bits, k_words, launch_method::async);
+            if (!r.has_value()) return false;
+        }
+        return ctx.wait_for_last_kernel(1'000'000'000ull).has_value();
+    });
+    // The whole token recorded into one command buffer and submitted once
+    const f64 gpu_gemv_sequence = time_tokens([&] {
+        if (!ctx.begin_sequence().has_value()) return false;
+        for (usize i = 0; i < std::size(block); ++i) {
+            const u32 k_words = (block[i].k_bits + 31u) / 32u;
+            auto r = device_kernel_launcher.binmatmul({d_act[i], d_wt[i], d_out[i]}, 1u, block[i].n, block[i].k_bits, k_words);
+            if (!r.has_value()) { ctx.cancel_sequence(); return false; }
+        }
+        auto token = ctx.submit_sequence();
+        return token.has_value() && ctx.wait_for_launch(token.value(), 1'000'000'000ull).has_value();
+    });
+    // The same sequence captured once, every token is a single replay
+    f64 gpu_gemv_graph = -1.0;
+    if (ctx.begin_capture().has_value()) {
+        bool recorded = true;
+        for (usize i = 0; i < std::size(block) && recorded; ++i) {
+            const u32 k_words = (block[i].k_bits + 31u) / 32u;
+            recorded = device_kernel_launcher.binmatmul({d_act[i], d_wt[i], d_out[i]}, 1u, block[i].n, block[i].k_bits, k_words).has_value();
+        }
+        auto graph = ctx.end_capture();
+        if (recorded && graph.has_value()) {
+            gpu_gemv_graph = time_tokens([&] {
+                auto token = ctx.replay(graph.value());
+                return token.has_value() && ctx.wait_for_launch(token.value(), 1'000'000'000ull).has_value();
+            });
+        }
+    }
+    ctx.exit();
+
+    if (gpu_tiled < 0.0 || gpu_gemv < 0.0 || gpu_subgroup < 0.0 || gpu_gemv_async < 0.0 || gpu_gemv_sequence < 0.0 || gpu_gemv_graph < 0.0) {
+        std::cout << "vulkan decode step failed\n";
+        return -1;
+    }
+    print_row("vulkan", "tiled", gpu_tiled, tokens, 0.0);
+    print_row("vulkan", "gemv", gpu_gemv, tokens, tokens / gpu_tiled);
+    if (gpu_subgroup > 0.0) print_row("vulkan", "subgroup", gpu_subgroup, tokens, tokens / gpu_tiled);
+    print_row("vulkan", "gemv async", gpu_gemv_async, tokens, tokens / gpu_tiled);
+    print_row("vulkan", "gemv sequence", gpu_gemv_sequence, tokens, tokens / gpu_tiled);
+    print_row("vulkan", "gemv graph", gpu_gemv_graph, tokens, tokens / gpu_tiled);
+#endif // TARGET_VULKAN_NATIVE
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <tether_io/config.hpp>
+#include <tether_io/context.hpp>
+#include <tether_io/algorithm.hpp>
+
+// Naive binmatmul.comp.glsl against the shared-memory binmatmul_tiled.comp.glsl and the register-blocked
+// binmatmul_microtile.comp.glsl for square M = N = K shapes from 256 to max_side. All run through the
+// automatic binmatmul path, the kernel is switched through the "binmatmul" entry of config.variants.
+//
+//   example_binmatmul_tiled_bench [max_side = 8192] [reps = 5]
+//
+// Gbop/s counts one XNOR and one popcount-add per bit: 2 * M * N * K_bits operations.
+// GB/s is the global traffic each kernel issues: the naive one reads a full row of A and column of B per
+// element of C, the tiled one reads them once per workgroup column / row and the micro-tiled one once per
+// invocation column / row. All write C once.
+
+namespace {
+
+[[maybe_unused]] auto print_row(tether_io::u32 side, const char* kernel, tether_io::f64 seconds, tether_io::f64 bytes, tether_io::f64 bit_ops, tether_io::f64 baseline) -> void {
+    std::cout << std::setw(8) << side
+              << std::setw(8) << kernel
+              << std::setw(12) << std::fixed << std::setprecision(3) << seconds * 1e3
+              << std::setw(12) << std::setprecision(1) << bytes / seconds * 1e-9
+              << std::setw(12) << std::setprecision(1) << bit_ops / seconds * 1e-9;
+    if (baseline > 0.0) std::cout << std::setw(9) << std::setprecision(2) << baseline / seconds << "x";
+    std::cout << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using namespace tether_io;
+
+    const u32 max_side = (argc > 1) ? static_cast<u32>(std::stoul(argv[1])) : 8192u;
+    const u32 reps     = (argc > 2) ? static_cast<u32>(std::stoul(argv[2])) : 5u;
+
+#ifdef TARGET_VULKAN_NATIVE
+    std::filesystem::path rsc = RESOURCE_DIR;
+    auto config = parse_application_settings(rsc / "settings.json");
+    if (!config.has_value()) {
+        std::cout << config.error() << std::endl;
+        return -1;
+    }
+    if (!config.value().kernels.contains("binmatmul_tiled")) {
+        std::cout << "index.json has no binmatmul_tiled entry\n";
+        return -1;
+    }
+
+    compute_context<device_driver::vulkan_native> ctx;
+    auto res = ctx.init(version<u32>{0, 1, 3, 0}, "binmatmul_tiled_bench");
+    if (res.has_value()) res = ctx.set_device(device_select::first_compute_capable);
+    if (!res.has_value()) {
+        std::cout << res.error() << std::endl;
+        return -1;
+    }
+
+    auto limits = ctx.limits();
+    if (!limits.has_value()) {
+        ctx.exit();
+        std::cout << limits.error() << std::endl;
+        return -1;
+    }
+    const auto max_local = limits.value().max_compute_work_group_size;
+
+    algorithm<device_driver::cpu_native, execution_method::standalone> host_kernel_launcher;
+    algorithm<device_driver::vulkan_native, execution_method::sequenced> device_kernel_launcher(ctx, config.value());
+
+    std::cout << "reps=" << reps << "\n";
+    std::cout << std::setw(8) << "M=N=K"
+              << std::setw(8) << "kernel"
+              << std::setw(12) << "ms"
+              << std::setw(12) << "GB/s"
+              << std::setw(12) << "Gbop/s"
+              << std::setw(10) << "speedup" << "\n";
+
+    for (u32 side = 256u; side <= max_side; side *= 2u) {
+        const u32 k_bits  = side;
+        const u32 k_words = (k_bits + 31u) / 32u;
+
+        auto A_res = host_kernel_launcher.random_mat_packed_u32(data_domain::pm_one, matrix_order::row_major, side, k_bits, 1234u);
+        auto B_res = host_kernel_launcher.random_mat_packed_u32(data_domain::pm_one, matrix_order::col_major, side, k_bits, 4321u);
+        if (!A_res.has_value() || !B_res.has_value()) {
+            ctx.exit();
+            std::cout << "could not generate operands for side=" << side << "\n";
+            return -1;
+        }
+
+        const usize c_size = static_cast<usize>(side) * side;
+        auto d_a = ctx.allocate(A_res.value().size() * sizeof(u32), alloc_method::device_local);
+        auto d_b = ctx.allocate(B_res.value().size() * sizeof(u32), alloc_method::device_local);
+        auto d_c = ctx.allocate(c_size * sizeof(i32), alloc_method::device_local);
+        if (!d_a.has_value() || !d_b.has_value() || !d_c.has_value()) {
+            ctx.exit();
+            std::cout << "device allocation failed for side=" << side << "\n";
+            return -1;
+        }
+        if (!ctx.upload(d_a.value(), std::span<u32>{A_res.value()}, upload_method::sync).has_value() ||
+            !ctx.upload(d_b.value(), std::span<u32>{B_res.value()}, upload_method::sync).has_value()) {
+            ctx.exit();
+            std::cout << "upload failed\n";
+            return -1;
+        }
+
+        // One warm-up launch (pipeline build, first-touch), then reps launches in flight behind a single wait
+        auto time_kernel = [&](const char* kernel, std::vector<i32>& out) -> f64 {
+            config.value().variants["binmatmul"] = kernel;
+            auto step = [&] {
+                return device_kernel_launcher.binmatmul({d_a.value(), d_b.value(), d_c.value()}, side, side, k_bits, k_words, launch_method::async).has_value();
+            };
+            if (!step() || !ctx.wait_for_last_kernel(10'000'000'000ull).has_value()) return -1.0;
+
+            auto t0 = std::chrono::steady_clock::now();
+            for (u32 r = 0; r < reps; ++r) {
+                if (!step()) return -1.0;
+            }
+            if (!ctx.wait_for_last_kernel(10'000'000'000ull).has_value()) return -1.0;
+            const f64 seconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - t0).count() / reps;
+
+            if (!ctx.download(std::span<i32>{out}, d_c.value(), download_method::sync).has_value()) return -1.0;
+            return seconds;
+        };
+
+        std::vector<i32> C_naive(c_size), C_tiled(c_size), C_micro(c_size);
+        const f64 naive_s = time_kernel("binmatmul", C_naive);
+        const f64 tiled_s = time_kernel("binmatmul_tiled", C_tiled);
+        const f64 micro_s = time_kernel("binmatmul_microtile", C_micro);
+
+        ctx.free(d_a.value());
+        ctx.free(d_b.value());
+        ctx.free(d_c.value());
+
+        if (naive_s < 0.0 || tiled_s < 0.0 || micro_s < 0.0) {
+            ctx.exit();
+            std::cout << "launch failed for side=" << side << "\n";
+            return -1;
+        }
+
+        const auto launch = binmatmul_launch_geometry(max_local, side, side, k_words);
+        const f64 m = side, n = side, kw = k_words;
+        const f64 c_bytes     = m * n * sizeof(i32);
+        const f64 naive_bytes = 2.0 * m * n * kw * sizeof(u32) + c_bytes;
+        const f64 tiled_bytes = (m * kw * launch.grid_size.x + n * kw * launch.grid_size.y) * sizeof(u32) + c_bytes;
+        const f64 micro_bytes = (m * kw * std::ceil(n / binmatmul_micro_tile.x) + n * kw * std::ceil(m / binmatmul_micro_tile.y)) * sizeof(u32) + c_bytes;
+        const f64 bit_ops     = 2.0 * m * n * static_cast<f64>(k_bits);
+
+        print_row(side, "naive", naive_s, naive_bytes, bit_ops, 0.0);
+        print_row(side, "tiled", tiled_s, tiled_bytes, bit_ops, naive_s);
+        print_row(side, "micro", micro_s, micro_bytes, bit_ops, naive_s);
+        if (C_naive != C_tiled || C_naive != C_micro) {
+            ctx.exit();
+            std::cout << "results differ for side=" << side << "\n";
+            return -1;
+        }
+    }
+
+    ctx.exit();
+#else
+    std::cout << "built without TARGET_VULKAN_NATIVE, nothing to compare (max_side=" << max_side << ", reps=" << reps << ")\n";
+#endif // TARGET_VULKAN_NATIVE
+
+    return 0;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <concepts>
+#include <memory>
 
 #include "types.hpp"
 #include "context.hpp"
@@ -11,12 +12,14 @@
 #include "algorithm/vulkan_native/fill.hpp"
 #include "algorithm/vulkan_native/multiply.hpp"
 #include "algorithm/vulkan_native/binmatmul.hpp"
+#include "algorithm/vulkan_native/ternmatmul.hpp"
 
 
 #endif // TARGET_VULKAN_NATIVE
 
 #include "algorithm/cpu_native/data_formatting.hpp"
 #include "algorithm/cpu_native/binmatmul.hpp"
+#include "algorithm/cpu_native/ternmatmul.hpp"
 
 namespace tether_io{
 
@@ -129,6 +132,43 @@ struct algorithm<D, execution_method::sequenced> {
         return{};
     };
 
+    // fill / multiply on kernels with binding_model::buffer_address, starting offset_bytes into d_buff
+    template<typename T>
+    requires std::same_as<T, f32>
+    auto fill_bda(
+        vec3<u32> work_group_size,
+        device_buffer<D>& d_buff,
+        T fill_value,
+        usize offset_bytes = 0
+    ) -> std::expected<void, device_error>{
+        std::expected<void, device_error> res;
+
+        if constexpr(D == device_driver::vulkan_native){
+            res = fill_bda_vulkan_native_sequenced(ctx, config, work_group_size, d_buff, fill_value, offset_bytes);
+        }
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return{};
+    };
+
+    template<typename T>
+    requires std::same_as<T, f32>
+    auto multiply_bda(
+        vec3<u32> work_group_size,
+        device_buffer<D>& d_buff,
+        T mull_factor,
+        usize offset_bytes = 0
+    ) -> std::expected<void, device_error>{
+        std::expected<void, device_error> res;
+
+        if constexpr(D == device_driver::vulkan_native){
+            res = multiply_bda_vulkan_native_sequenced(ctx, config, work_group_size, d_buff, mull_factor, offset_bytes);
+        }
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return{};
+    };
+
     template<typename... Args>
     auto binmatmul(
         vec3<u32> grid_size,
@@ -147,25 +187,185 @@ struct algorithm<D, execution_method::sequenced> {
         return{};
     }
 
+    // binmatmul with A, B and C passed as device addresses instead of descriptors (binding_model::buffer_address)
+    template<typename... Args>
+    auto binmatmul_bda(
+        vec3<u32> grid_size,
+        vec3<u32> local_size,
+        std::initializer_list<device_buffer<D>> d_buffers,
+        u32 m, u32 n, u32 k_bits, u32 k_words,
+        Args&&... opts
+    ) -> std::expected<void, device_error>{
+        std::expected<void, device_error> res;
+
+        if constexpr(D == device_driver::vulkan_native){
+            res = binmatmul_bda_vulkan_native_sequenced(ctx, config, grid_size, local_size, d_buffers, m, n, k_bits, k_words, opts...);
+        }
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return{};
+    }
+
+    // One subgroup per element of C, grid x covers N in steps of local_size.x / subgroup_size, y the M rows
+    template<typename... Args>
+    auto binmatmul_subgroup(
+        vec3<u32> grid_size,
+        vec3<u32> local_size,
+        u32 subgroup_size,
+        std::initializer_list<device_buffer<D>> d_buffers,
+        u32 m, u32 n, u32 k_bits, u32 k_words,
+        Args&&... opts
+    ) -> std::expected<void, device_error>{
+        std::expected<void, device_error> res;
+
+        if constexpr(D == device_driver::vulkan_native){
+            res = binmatmul_subgroup_vulkan_native_sequenced(ctx, config, grid_size, local_size, subgroup_size, d_buffers, m, n, k_bits, k_words, opts...);
+        }
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return{};
+    }
+
+    // Each invocation computes a tile.y x tile.x block of C, grid x covers N in steps of local_size.x * tile.x, y the M rows likewise
+    template<typename... Args>
+    auto binmatmul_microtile(
+        vec3<u32> grid_size,
+        vec3<u32> local_size,
+        vec2<u32> tile,
+        std::initializer_list<device_buffer<D>> d_buffers,
+        u32 m, u32 n, u32 k_bits, u32 k_words,
+        Args&&... opts
+    ) -> std::expected<void, device_error>{
+        std::expected<void, device_error> res;
+
+        if constexpr(D == device_driver::vulkan_native){
+            res = binmatmul_microtile_vulkan_native_sequenced(ctx, config, grid_size, local_size, tile, d_buffers, m, n, k_bits, k_words, opts...);
+        }
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return{};
+    }
+
+    // local_size.x invocations reduce K for one element of C, grid x covers N in steps of local_size.y, y the M rows
+    template<typename... Args>
+    auto binmatmul_gemv(
+        vec3<u32> grid_size,
+        vec3<u32> local_size,
+        std::initializer_list<device_buffer<D>> d_buffers,
+        u32 m, u32 n, u32 k_bits, u32 k_words,
+        Args&&... opts
+    ) -> std::expected<void, device_error>{
+        std::expected<void, device_error> res;
+
+        if constexpr(D == device_driver::vulkan_native){
+            res = binmatmul_gemv_vulkan_native_sequenced(ctx, config, grid_size, local_size, d_buffers, m, n, k_bits, k_words, opts...);
+        }
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return{};
+    }
+
+    // Picks the kernel and launch shape from the device limits: decode shapes (m <= binmatmul_gemv_max_rows) run the GEMV kernel,
+    // other long-K shapes with few elements of C the subgroup kernel where the device has subgroup arithmetic.
+    // The 2D grid is sized for the kernel index.json selects, binmatmul_microtile covers binmatmul_micro_tile elements per invocation.
+    template<typename... Args>
+    auto binmatmul(
+        std::initializer_list<device_buffer<D>> d_buffers,
+        u32 m, u32 n, u32 k_bits, u32 k_words,
+        Args&&... opts
+    ) -> std::expected<void, device_error>{
+        std::expected<void, device_error> res;
+
+        if constexpr(D == device_driver::vulkan_native){
+            auto limits = ctx.limits();
+            if (!limits.has_value()) return std::unexpected{ limits.error() };
+
+            const auto max_local = limits.value().max_compute_work_group_size;
+            if (config.kernels.contains("binmatmul_subgroup") && binmatmul_prefers_subgroup(limits.value(), m, n, k_bits)) {
+                const u32 subgroup_size = limits.value().subgroup_size;
+                const auto launch = binmatmul_subgroup_launch_geometry(max_local, subgroup_size, m, n);
+                res = binmatmul_subgroup_vulkan_native_sequenced(ctx, config, launch.grid_size, launch.local_size, subgroup_size, d_buffers, m, n, k_bits, k_words, opts...);
+            } else {
+                const auto launch = binmatmul_launch_geometry(max_local, m, n, k_words, binmatmul_variant_tile(config));
+                if (launch.gemv) {
+                    res = binmatmul_gemv_vulkan_native_sequenced(ctx, config, launch.grid_size, launch.local_size, d_buffers, m, n, k_bits, k_words, opts...);
+                } else {
+                    res = binmatmul_vulkan_native_sequenced(ctx, config, launch.grid_size, launch.local_size, d_buffers, m, n, k_bits, k_words, opts...);
+                }
+            }
+        }
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return{};
+    }
+
+    // Same grid / local size contract as binmatmul: x covers the N columns of C, y the M rows
+    template<typename... Args>
+    auto ternmatmul(
+        vec3<u32> grid_size,
+        vec3<u32> local_size,
+        std::initializer_list<device_buffer<D>> d_buffers,
+        u32 m, u32 n, u32 k_bits, u32 k_words,
+        Args&&... opts
+    ) -> std::expected<void, device_error>{
+        std::expected<void, device_error> res;
+
+        if constexpr(D == device_driver::vulkan_native){
+            res = ternmatmul_vulkan_native_sequenced(ctx, config, grid_size, local_size, d_buffers, m, n, k_bits, k_words, opts...);
+        }
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return{};
+    }
+
 };
 
 template <> struct algorithm<device_driver::cpu_native, execution_method::standalone>{
+    // Worker pool of the parallel kernels, created on first use so single-threaded callers never spawn threads
+    std::unique_ptr<cpu_thread_pool> pool;
+    usize thread_count { 0 };
+
+    // Pack buffers reused by binmatmul_blocked, steady-state calls with span outputs never allocate
+    cpu_gemm_workspace workspace;
+
+    // 0 selects std::thread::hardware_concurrency(), takes effect on the next parallel call
+    auto set_thread_count(usize count) -> void {
+        if (pool && count == thread_count) return;
+        thread_count = count;
+        pool.reset();
+    }
 
+    auto thread_pool() -> cpu_thread_pool& {
+        if (!pool) pool = std::make_unique<cpu_thread_pool>(thread_count);
+        return *pool;
+    }
+
+    // Uses the widest instruction set detected at runtime
     auto f32_mat_to_packed_u32(
         matrix_order order,
-        std::span<f32> in,
+        std::span<const f32> in,
         u32 matrix_side,
         u32 k_bits
+    ) -> std::expected<std::vector<u32>, device_error>{
+        return f32_mat_to_packed_u32(order, in, matrix_side, k_bits, best_cpu_isa());
+    }
+
+    auto f32_mat_to_packed_u32(
+        matrix_order order,
+        std::span<const f32> in,
+        u32 matrix_side,
+        u32 k_bits,
+        cpu_isa isa
     ) -> std::expected<std::vector<u32>, device_error>{
         std::expected<std::vector<u32>, device_error> res;
 
         if (order == matrix_order::row_major){
-            res = f32_mat_to_packed_u32_row_major_cpu_native_standalone(
-                in, matrix_side, k_bits
+            res = f32_mat_to_packed_u32_row_major_isa_cpu_native_standalone(
+                in, matrix_side, k_bits, isa
             );   
         }else{
-            res = f32_mat_to_packed_u32_col_major_cpu_native_standalone(
-                in, matrix_side, k_bits
+            res = f32_mat_to_packed_u32_col_major_isa_cpu_native_standalone(
+                in, matrix_side, k_bits, isa
             ); 
         }
 
@@ -173,15 +373,202 @@ template <> struct algorithm<device_driver::cpu_native, execution_method::standa
         return res.value();
     }
 
+    // Packs into `out`, which must hold exactly matrix_side * k_words words
+    auto f32_mat_to_packed_u32(
+        matrix_order order,
+        std::span<const f32> in,
+        std::span<u32> out,
+        u32 matrix_side,
+        u32 k_bits,
+        cpu_isa isa = best_cpu_isa()
+    ) -> std::expected<void, device_error>{
+        if (order == matrix_order::row_major){
+            return f32_mat_to_packed_u32_row_major_isa_cpu_native_standalone(in, out, matrix_side, k_bits, isa);
+        }
+        return f32_mat_to_packed_u32_col_major_isa_cpu_native_standalone(in, out, matrix_side, k_bits, isa);
+    }
+
+    // Two-plane ternary packing, see f32_mat_to_packed_ternary_u32_row_major_cpu_native_standalone
+    auto f32_mat_to_packed_ternary_u32(
+        matrix_order order,
+        std::span<const f32> in,
+        u32 matrix_side,
+        u32 k_bits
+    ) -> std::expected<std::vector<u32>, device_error>{
+        std::expected<std::vector<u32>, device_error> res;
+
+        if (order == matrix_order::row_major){
+            res = f32_mat_to_packed_ternary_u32_row_major_cpu_native_standalone(in, matrix_side, k_bits);
+        }else{
+            res = f32_mat_to_packed_ternary_u32_col_major_cpu_native_standalone(in, matrix_side, k_bits);
+        }
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return res.value();
+    }
+
+    auto f32_mat_to_packed_ternary_u32(
+        matrix_order order,
+        std::span<const f32> in,
+        std::span<u32> out,
+        u32 matrix_side,
+        u32 k_bits
+    ) -> std::expected<void, device_error>{
+        if (order == matrix_order::row_major){
+            return f32_mat_to_packed_ternary_u32_row_major_cpu_native_standalone(in, out, matrix_side, k_bits);
+        }
+        return f32_mat_to_packed_ternary_u32_col_major_cpu_native_standalone(in, out, matrix_side, k_bits);
+    }
 
+    // Uses the widest instruction set detected at runtime
     auto binmatmul(
         std::span<const u32> a_bits,
         std::span<const u32> b_bits,
         u32 m, u32 n, u32 k_bits
+    ) -> std::expected<std::vector<i32>, device_error>{
+        return binmatmul(a_bits, b_bits, m, n, k_bits, best_cpu_isa());
+    }
+
+    auto binmatmul(
+        std::span<const u32> a_bits,
+        std::span<const u32> b_bits,
+        u32 m, u32 n, u32 k_bits,
+        cpu_isa isa
     ) -> std::expected<std::vector<i32>, device_error>{
         std::expected<std::vector<i32>, device_error> res;
 
-        res = binmatmul_cpu_native_standalone(a_bits, b_bits, m, n, k_bits);
+        res = binmatmul_isa_cpu_native_standalone(a_bits, b_bits, m, n, k_bits, isa);
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return res.value();
+    }
+
+    // Writes C into `c`, which must hold exactly m * n elements
+    auto binmatmul(
+        std::span<const u32> a_bits,
+        std::span<const u32> b_bits,
+        std::span<i32> c,
+        u32 m, u32 n, u32 k_bits,
+        cpu_isa isa = best_cpu_isa()
+    ) -> std::expected<void, device_error>{
+        return binmatmul_isa_cpu_native_standalone(a_bits, b_bits, c, m, n, k_bits, isa);
+    }
+
+    // Cache-blocked packed engine, block sizes can be tuned per machine through `blocking`
+    auto binmatmul_blocked(
+        std::span<const u32> a_bits,
+        std::span<const u32> b_bits,
+        u32 m, u32 n, u32 k_bits,
+        cpu_gemm_blocking blocking = {},
+        cpu_isa isa = best_cpu_isa()
+    ) -> std::expected<std::vector<i32>, device_error>{
+        std::expected<std::vector<i32>, device_error> res;
+
+        res = binmatmul_blocked_cpu_native_standalone(a_bits, b_bits, m, n, k_bits, blocking, isa);
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return res.value();
+    }
+
+    auto binmatmul_blocked(
+        std::span<const u32> a_bits,
+        std::span<const u32> b_bits,
+        std::span<i32> c,
+        u32 m, u32 n, u32 k_bits,
+        cpu_gemm_blocking blocking = {},
+        cpu_isa isa = best_cpu_isa()
+    ) -> std::expected<void, device_error>{
+        return binmatmul_blocked_cpu_native_standalone(a_bits, b_bits, c, m, n, k_bits, blocking, workspace, isa);
+    }
+
+    // Tiles of C (tile_size.x columns by tile_size.y rows) are scheduled over the thread pool with work stealing.
+    // Decode-shaped calls (m <= binmatmul_gemv_max_rows) take the GEMV path instead and ignore tile_size.
+    auto binmatmul_parallel(
+        std::span<const u32> a_bits,
+        std::span<const u32> b_bits,
+        u32 m, u32 n, u32 k_bits,
+        vec2<u32> tile_size = {128u, 32u},
+        cpu_isa isa = best_cpu_isa()
+    ) -> std::expected<std::vector<i32>, device_error>{
+        std::vector<i32> c(static_cast<usize>(m) * n);
+
+        auto res = binmatmul_parallel(a_bits, b_bits, c, m, n, k_bits, tile_size, isa);
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return c;
+    }
+
+    auto binmatmul_parallel(
+        std::span<const u32> a_bits,
+        std::span<const u32> b_bits,
+        std::span<i32> c,
+        u32 m, u32 n, u32 k_bits,
+        vec2<u32> tile_size = {128u, 32u},
+        cpu_isa isa = best_cpu_isa()
+    ) -> std::expected<void, device_error>{
+        if (m <= binmatmul_gemv_max_rows) {
+            return binmatmul_gemv_cpu_native_standalone(thread_pool(), a_bits, b_bits, c, m, n, k_bits, isa);
+        }
+        return binmatmul_parallel_cpu_native_standalone(thread_pool(), a_bits, b_bits, c, m, n, k_bits, tile_size, isa);
+    }
+
+    // B streamed once in column chunks over the thread pool, meant for m of a few decode tokens
+    auto binmatmul_gemv(
+        std::span<const u32> a_bits,
+        std::span<const u32> b_bits,
+        u32 m, u32 n, u32 k_bits,
+        cpu_isa isa = best_cpu_isa()
+    ) -> std::expected<std::vector<i32>, device_error>{
+        std::expected<std::vector<i32>, device_error> res;
+
+        res = binmatmul_gemv_cpu_native_standalone(thread_pool(), a_bits, b_bits, m, n, k_bits, isa);
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return res.value();
+    }
+
+    auto binmatmul_gemv(
+        std::span<const u32> a_bits,
+        std::span<const u32> b_bits,
+        std::span<i32> c,
+        u32 m, u32 n, u32 k_bits,
+        cpu_isa isa = best_cpu_isa()
+    ) -> std::expected<void, device_error>{
+        return binmatmul_gemv_cpu_native_standalone(thread_pool(), a_bits, b_bits, c, m, n, k_bits, isa);
+    }
+
+    auto ternmatmul(
+        std::span<const u32> a_planes,
+        std::span<const u32> b_planes,
+        u32 m, u32 n, u32 k_bits,
+        cpu_isa isa = best_cpu_isa()
+    ) -> std::expected<std::vector<i32>, device_error>{
+        std::expected<std::vector<i32>, device_error> res;
+
+        res = ternmatmul_isa_cpu_native_standalone(a_planes, b_planes, m, n, k_bits, isa);
+
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return res.value();
+    }
+
+    auto ternmatmul(
+        std::span<const u32> a_planes,
+        std::span<const u32> b_planes,
+        std::span<i32> c,
+        u32 m, u32 n, u32 k_bits,
+        cpu_isa isa = best_cpu_isa()
+    ) -> std::expected<void, device_error>{
+        return ternmatmul_isa_cpu_native_standalone(a_planes, b_planes, c, m, n, k_bits, isa);
+    }
+
+    // Unpacked f32 GEMM of the ternary-quantized inputs, the ground truth for the packed ternary kernels
+    auto ternmatmul_reference(
+        std::span<const f32> a,
+        std::span<const f32> b,
+        u32 m, u32 n, u32 k
+    ) -> std::expected<std::vector<i32>, device_error>{
+        std::expected<std::vector<i32>, device_error> res;
+
+        res = ternmatmul_f32_reference_cpu_native_standalone(a, b, m, n, k);
 
         if (!res.has_value()) return std::unexpected{ res.error() };
         return res.value();
@@ -193,35 +580,86 @@ template <> struct algorithm<device_driver::cpu_native, execution_method::standa
         u32 cols, 
         u32 seed
     ) -> std::expected<std::vector<f32>, device_error>{
-        std::expected<std::vector<f32>, device_error> res;
-
-        switch(data_range){
+        std::vector<f32> out(static_cast<usize>(rows) * cols);
 
-            case data_domain::pm_one: 
-                 res = random_mat_binary_f32_1d_pm_one_dist_cpu_native_standalone(rows, cols, seed);
-                 break;
-            case data_domain::zero_one:
-                res = random_mat_binary_f32_1d_zero_one_dist_cpu_native_standalone(rows, cols, seed);
-                break;
-            case data_domain::full_range:
-                res = random_mat_binary_f32_1d_full_range_dist_cpu_native_standalone(rows, cols, seed);
-                break;
-            case data_domain::trinary:
-                res = random_mat_binary_f32_1d_trinary_dist_cpu_native_standalone(rows, cols, seed);
-                break;
-            default:
-                return std::unexpected{device_error::not_available};
+        auto res = random_mat_binary_f32_1d(data_range, out, rows, cols, seed);
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return out;
+    }
 
+    // Filled in parallel on the member pool, the output only depends on the seed and never on the thread count
+    // or the instruction set
+    auto random_mat_binary_f32_1d(
+        data_domain data_range,
+        std::span<f32> out,
+        u32 rows, 
+        u32 cols, 
+        u32 seed,
+        cpu_isa isa = best_cpu_isa()
+    ) -> std::expected<void, device_error>{
+        switch(data_range){
+            case data_domain::pm_one:     return random_mat_binary_f32_1d_pm_one_dist_cpu_native_standalone(thread_pool(), out, rows, cols, seed, isa);
+            case data_domain::zero_one:   return random_mat_binary_f32_1d_zero_one_dist_cpu_native_standalone(thread_pool(), out, rows, cols, seed, isa);
+            case data_domain::full_range: return random_mat_binary_f32_1d_full_range_dist_cpu_native_standalone(thread_pool(), out, rows, cols, seed, isa);
+            case data_domain::trinary:    return random_mat_binary_f32_1d_trinary_dist_cpu_native_standalone(thread_pool(), out, rows, cols, seed, isa);
+            default:                      return std::unexpected{device_error::not_available};
         }
+    }
 
+    // Packed random operands without the f32 matrix in between. Bit-identical to random_mat_binary_f32_1d
+    // followed by f32_mat_to_packed_u32 with the same order, i.e. row_major packs the [matrix_side x k_bits]
+    // matrix of that seed and col_major the [k_bits x matrix_side] one.
+    auto random_mat_packed_u32(
+        data_domain data_range,
+        matrix_order order,
+        u32 matrix_side,
+        u32 k_bits,
+        u32 seed
+    ) -> std::expected<std::vector<u32>, device_error>{
+        std::vector<u32> out(static_cast<usize>(matrix_side) * ((k_bits + 31u) / 32u));
 
+        auto res = random_mat_packed_u32(data_range, order, out, matrix_side, k_bits, seed);
         if (!res.has_value()) return std::unexpected{ res.error() };
-        return res.value();
+        return out;
     }
 
-};
+    auto random_mat_packed_u32(
+        data_domain data_range,
+        matrix_order order,
+        std::span<u32> out,
+        u32 matrix_side,
+        u32 k_bits,
+        u32 seed
+    ) -> std::expected<void, device_error>{
+        return random_mat_packed_u32_cpu_native_standalone(thread_pool(), data_range, order, out, matrix_side, k_bits, seed);
+    }
 
-} // namespace tether_io
+    // Same for the ternary (sign, nonzero) planes of f32_mat_to_packed_ternary_u32
+    auto random_mat_packed_ternary_u32(
+        data_domain data_range,
+        matrix_order order,
+        u32 matrix_side,
+        u32 k_bits,
+        u32 seed
+    ) -> std::expected<std::vector<u32>, device_error>{
+        std::vector<u32> out(static_cast<usize>(matrix_side) * ((k_bits + 31u) / 32u) * 2u);
 
+        auto res = random_mat_packed_ternary_u32(data_range, order, out, matrix_side, k_bits, seed);
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        return out;
+    }
 
+    auto random_mat_packed_ternary_u32(
+        data_domain data_range,
+        matrix_order order,
+        std::span<u32> out,
+        u32 matrix_side,
+        u32 k_bits,
+        u32 seed
+    ) -> std::expected<void, device_error>{
+        return random_mat_packed_ternary_u32_cpu_native_standalone(thread_pool(), data_range, order, out, matrix_side, k_bits, seed);
+    }
+
+};
 
+} // namespace tether_io
@@ -2,27 +2,37 @@
 
 #include <span>
 #include <expected>
+#include <vector>
+#include <bit>
+#include <algorithm>
 
 #include "../../types.hpp"
+#include "cpu_features.hpp"
+#include "thread_pool.hpp"
 
 namespace tether_io{
 
+// Output overloads write C into a caller-provided span of exactly m * n elements and never allocate,
+// the vector-returning overloads allocate C and forward to them.
 auto binmatmul_cpu_native_standalone(
     std::span<const u32> a_bits,
     std::span<const u32> b_bits,
+    std::span<i32> c,
     u32 m, u32 n, u32 k_bits
-) -> std::expected<std::vector<i32>, device_error> {
+) -> std::expected<void, device_error> {
     const u32 k_words = (k_bits + 31u) / 32u;
 
     const usize a_needed = static_cast<usize>(m) * k_words; // A: [m x k_words]
     const usize b_needed = static_cast<usize>(n) * k_words; // B: [n x k_words], each original column becomes a row
 
-    if (a_bits.size() != a_needed || b_bits.size() != b_needed) {
+    if (a_bits.size() != a_needed || b_bits.size() != b_needed || c.size() != static_cast<usize>(m) * n) {
         return std::unexpected(device_error::launch_failed);
     }
 
-    std::vector<i32> c;
-    c.assign(static_cast<usize>(m) * n, 0);
+    if (k_words == 0u) {
+        std::fill(c.begin(), c.end(), 0);
+        return {};
+    }
 
     const u32 rem        = (k_bits & 31u);
     const u32 tail_mask  = (rem == 0u) ? 0xFFFFFFFFu : ((1u << rem) - 1u);
@@ -46,6 +56,892 @@ auto binmatmul_cpu_native_standalone(
         }
     }
 
+    return {};
+}
+
+auto binmatmul_cpu_native_standalone(
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    u32 m, u32 n, u32 k_bits
+) -> std::expected<std::vector<i32>, device_error> {
+    std::vector<i32> c(static_cast<usize>(m) * n);
+
+    auto res = binmatmul_cpu_native_standalone(a_bits, b_bits, c, m, n, k_bits);
+    if (!res.has_value()) return std::unexpected(res.error());
+    return c;
+}
+
+} // tether_io
+
+namespace {
+
+// The vectorized kernels below count mismatching bits instead of matching ones:
+//   dot = 2 * popcount(~(a ^ b) & mask) - k_bits = k_bits - 2 * popcount((a ^ b) & mask)
+// All full words are reduced with SIMD, only the final (possibly partial) word is masked, which takes
+// the tail branch out of the inner loop while staying bit-exact with the scalar reference.
+
+static inline auto xor_popcount_tail(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::u32 last, tether_io::u32 tail_mask
+) -> tether_io::u32 {
+    return static_cast<tether_io::u32>(std::popcount((a[last] ^ b[last]) & tail_mask));
+}
+
+#ifdef TETHER_IO_ARCH_X86_64
+
+// Per 64-bit lane popcount with the nibble lookup table (Mula), vpsadbw folds the byte counts.
+TETHER_IO_TARGET_AVX2 static inline auto popcount_epi64_avx2(__m256i v) -> __m256i {
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+    );
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_and_si256(v, low_mask);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    const __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+}
+
+// Carry-save adder: (h, l) = a + b + c bitwise
+TETHER_IO_TARGET_AVX2 static inline auto csa_avx2(__m256i& h, __m256i& l, __m256i a, __m256i b, __m256i c) -> void {
+    const __m256i u = _mm256_xor_si256(a, b);
+    h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    l = _mm256_xor_si256(u, c);
+}
+
+TETHER_IO_TARGET_AVX2 static inline auto load_xor_avx2(const tether_io::u32* a, const tether_io::u32* b, tether_io::usize i) -> __m256i {
+    return _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i))
+    );
+}
+
+// popcount(a ^ b) over `words` full words. Long rows go through a Harley-Seal carry-save tree so only
+// one in sixteen vectors needs the lookup popcount, shorter remainders use the lookup directly.
+TETHER_IO_TARGET_AVX2 static inline auto xor_popcount_avx2(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::u32 words
+) -> tether_io::u32 {
+    constexpr tether_io::u32 lanes = 8u; // u32 words per ymm
+    const tether_io::u32 vectors = words / lanes;
+
+    __m256i total  = _mm256_setzero_si256();
+    __m256i ones   = _mm256_setzero_si256();
+    __m256i twos   = _mm256_setzero_si256();
+    __m256i fours  = _mm256_setzero_si256();
+    __m256i eights = _mm256_setzero_si256();
+    __m256i sixteens, twos_a, twos_b, fours_a, fours_b, eights_a, eights_b;
+
+    tether_io::u32 v = 0;
+    for (; v + 16u <= vectors; v += 16u) {
+        const tether_io::usize i = static_cast<tether_io::usize>(v) * lanes;
+        csa_avx2(twos_a, ones, ones, load_xor_avx2(a, b, i +   0), load_xor_avx2(a, b, i +   8));
+        csa_avx2(twos_b, ones, ones, load_xor_avx2(a, b, i +  16), load_xor_avx2(a, b, i +  24));
+        csa_avx2(fours_a, twos, twos, twos_a, twos_b);
+        csa_avx2(twos_a, ones, ones, load_xor_avx2(a, b, i +  32), load_xor_avx2(a, b, i +  40));
+        csa_avx2(twos_b, ones, ones, load_xor_avx2(a, b, i +  48), load_xor_avx2(a, b, i +  56));
+        csa_avx2(fours_b, twos, twos, twos_a, twos_b);
+        csa_avx2(eights_a, fours, fours, fours_a, fours_b);
+        csa_avx2(twos_a, ones, ones, load_xor_avx2(a, b, i +  64), load_xor_avx2(a, b, i +  72));
+        csa_avx2(twos_b, ones, ones, load_xor_avx2(a, b, i +  80), load_xor_avx2(a, b, i +  88));
+        csa_avx2(fours_a, twos, twos, twos_a, twos_b);
+        csa_avx2(twos_a, ones, ones, load_xor_avx2(a, b, i +  96), load_xor_avx2(a, b, i + 104));
+        csa_avx2(twos_b, ones, ones, load_xor_avx2(a, b, i + 112), load_xor_avx2(a, b, i + 120));
+        csa_avx2(fours_b, twos, twos, twos_a, twos_b);
+        csa_avx2(eights_b, fours, fours, fours_a, fours_b);
+        csa_avx2(sixteens, eights, eights, eights_a, eights_b);
+        total = _mm256_add_epi64(total, popcount_epi64_avx2(sixteens));
+    }
+
+    total = _mm256_slli_epi64(total, 4);
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_epi64_avx2(eights), 3));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_epi64_avx2(fours), 2));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_epi64_avx2(twos), 1));
+    total = _mm256_add_epi64(total, popcount_epi64_avx2(ones));
+
+    for (; v < vectors; ++v) {
+        total = _mm256_add_epi64(total, popcount_epi64_avx2(load_xor_avx2(a, b, static_cast<tether_io::usize>(v) * lanes)));
+    }
+
+    tether_io::u64 count =
+        static_cast<tether_io::u64>(_mm256_extract_epi64(total, 0)) +
+        static_cast<tether_io::u64>(_mm256_extract_epi64(total, 1)) +
+        static_cast<tether_io::u64>(_mm256_extract_epi64(total, 2)) +
+        static_cast<tether_io::u64>(_mm256_extract_epi64(total, 3));
+
+    for (tether_io::u32 kw = vectors * lanes; kw < words; ++kw) {
+        count += static_cast<tether_io::u64>(_mm_popcnt_u32(a[kw] ^ b[kw]));
+    }
+
+    return static_cast<tether_io::u32>(count);
+}
+
+TETHER_IO_TARGET_AVX2 static auto binmatmul_rows_avx2(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::i32* c,
+    tether_io::u32 m, tether_io::u32 n, tether_io::u32 ldc,
+    tether_io::u32 k_bits, tether_io::u32 k_words, tether_io::u32 tail_mask
+) -> void {
+    for (tether_io::u32 r = 0; r < m; ++r) {
+        const tether_io::u32* a_row = a + static_cast<tether_io::usize>(r) * k_words;
+        tether_io::i32* c_row = c + static_cast<tether_io::usize>(r) * ldc;
+
+        for (tether_io::u32 col = 0; col < n; ++col) {
+            const tether_io::u32* b_row = b + static_cast<tether_io::usize>(col) * k_words;
+            const tether_io::u32 mismatches =
+                xor_popcount_avx2(a_row, b_row, k_words - 1u) +
+                xor_popcount_tail(a_row, b_row, k_words - 1u, tail_mask);
+            c_row[col] = static_cast<tether_io::i32>(k_bits) - 2 * static_cast<tether_io::i32>(mismatches);
+        }
+    }
+}
+
+// popcount(a ^ b) over `words` full words, one vpopcntq per 512 bits and a masked load for the remainder.
+TETHER_IO_TARGET_AVX512_VPOPCNTDQ static inline auto xor_popcount_avx512(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::u32 words
+) -> tether_io::u32 {
+    constexpr tether_io::u32 lanes = 16u; // u32 words per zmm
+    __m512i total = _mm512_setzero_si512();
+
+    tether_io::u32 kw = 0;
+    for (; kw + lanes <= words; kw += lanes) {
+        const __m512i x = _mm512_xor_si512(_mm512_loadu_si512(a + kw), _mm512_loadu_si512(b + kw));
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(x));
+    }
+
+    if (kw < words) {
+        const __mmask16 rest = static_cast<__mmask16>((1u << (words - kw)) - 1u);
+        const __m512i x = _mm512_xor_si512(_mm512_maskz_loadu_epi32(rest, a + kw), _mm512_maskz_loadu_epi32(rest, b + kw));
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(x));
+    }
+
+    return static_cast<tether_io::u32>(_mm512_reduce_add_epi64(total));
+}
+
+TETHER_IO_TARGET_AVX512_VPOPCNTDQ static auto binmatmul_rows_avx512(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::i32* c,
+    tether_io::u32 m, tether_io::u32 n, tether_io::u32 ldc,
+    tether_io::u32 k_bits, tether_io::u32 k_words, tether_io::u32 tail_mask
+) -> void {
+    for (tether_io::u32 r = 0; r < m; ++r) {
+        const tether_io::u32* a_row = a + static_cast<tether_io::usize>(r) * k_words;
+        tether_io::i32* c_row = c + static_cast<tether_io::usize>(r) * ldc;
+
+        for (tether_io::u32 col = 0; col < n; ++col) {
+            const tether_io::u32* b_row = b + static_cast<tether_io::usize>(col) * k_words;
+            const tether_io::u32 mismatches =
+                xor_popcount_avx512(a_row, b_row, k_words - 1u) +
+                xor_popcount_tail(a_row, b_row, k_words - 1u, tail_mask);
+            c_row[col] = static_cast<tether_io::i32>(k_bits) - 2 * static_cast<tether_io::i32>(mismatches);
+        }
+    }
+}
+
+#endif // TETHER_IO_ARCH_X86_64
+
+#ifdef TETHER_IO_ARCH_ARM64
+
+// popcount(a ^ b) over `words` full words, vcnt per byte and pairwise widening adds into u32 lanes.
+static inline auto xor_popcount_neon(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::u32 words
+) -> tether_io::u32 {
+    uint32x4_t total = vdupq_n_u32(0);
+
+    tether_io::u32 kw = 0;
+    for (; kw + 4u <= words; kw += 4u) {
+        const uint8x16_t x = vreinterpretq_u8_u32(veorq_u32(vld1q_u32(a + kw), vld1q_u32(b + kw)));
+        total = vpadalq_u16(total, vpaddlq_u8(vcntq_u8(x)));
+    }
+
+    tether_io::u32 count = vaddvq_u32(total);
+    for (; kw < words; ++kw) {
+        count += static_cast<tether_io::u32>(std::popcount(a[kw] ^ b[kw]));
+    }
+    return count;
+}
+
+static auto binmatmul_rows_neon(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::i32* c,
+    tether_io::u32 m, tether_io::u32 n, tether_io::u32 ldc,
+    tether_io::u32 k_bits, tether_io::u32 k_words, tether_io::u32 tail_mask
+) -> void {
+    for (tether_io::u32 r = 0; r < m; ++r) {
+        const tether_io::u32* a_row = a + static_cast<tether_io::usize>(r) * k_words;
+        tether_io::i32* c_row = c + static_cast<tether_io::usize>(r) * ldc;
+
+        for (tether_io::u32 col = 0; col < n; ++col) {
+            const tether_io::u32* b_row = b + static_cast<tether_io::usize>(col) * k_words;
+            const tether_io::u32 mismatches =
+                xor_popcount_neon(a_row, b_row, k_words - 1u) +
+                xor_popcount_tail(a_row, b_row, k_words - 1u, tail_mask);
+            c_row[col] = static_cast<tether_io::i32>(k_bits) - 2 * static_cast<tether_io::i32>(mismatches);
+        }
+    }
+}
+
+#endif // TETHER_IO_ARCH_ARM64
+
+// Computes the m x n block of C whose rows start at `a` and columns at `b`, `ldc` is the row stride of C
+using binmatmul_rows_fn = void (*)(
+    const tether_io::u32*, const tether_io::u32*, tether_io::i32*,
+    tether_io::u32, tether_io::u32, tether_io::u32,
+    tether_io::u32, tether_io::u32, tether_io::u32
+);
+
+static auto binmatmul_rows_scalar(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::i32* c,
+    tether_io::u32 m, tether_io::u32 n, tether_io::u32 ldc,
+    tether_io::u32 k_bits, tether_io::u32 k_words, tether_io::u32 tail_mask
+) -> void {
+    for (tether_io::u32 r = 0; r < m; ++r) {
+        const tether_io::u32* a_row = a + static_cast<tether_io::usize>(r) * k_words;
+        tether_io::i32* c_row = c + static_cast<tether_io::usize>(r) * ldc;
+
+        for (tether_io::u32 col = 0; col < n; ++col) {
+            const tether_io::u32* b_row = b + static_cast<tether_io::usize>(col) * k_words;
+
+            tether_io::u32 mismatches = xor_popcount_tail(a_row, b_row, k_words - 1u, tail_mask);
+            for (tether_io::u32 kw = 0; kw + 1u < k_words; ++kw) {
+                mismatches += static_cast<tether_io::u32>(std::popcount(a_row[kw] ^ b_row[kw]));
+            }
+            c_row[col] = static_cast<tether_io::i32>(k_bits) - 2 * static_cast<tether_io::i32>(mismatches);
+        }
+    }
+}
+
+static inline auto select_binmatmul_rows(tether_io::cpu_isa isa) -> binmatmul_rows_fn {
+    switch (isa) {
+#ifdef TETHER_IO_ARCH_X86_64
+        case tether_io::cpu_isa::avx2:             return binmatmul_rows_avx2;
+        case tether_io::cpu_isa::avx512_vpopcntdq: return binmatmul_rows_avx512;
+#endif
+#ifdef TETHER_IO_ARCH_ARM64
+        case tether_io::cpu_isa::neon:             return binmatmul_rows_neon;
+#endif
+        default:                                   return binmatmul_rows_scalar;
+    }
+}
+
+static inline auto binmatmul_packed_cpu_native(
+    std::span<const tether_io::u32> a_bits,
+    std::span<const tether_io::u32> b_bits,
+    std::span<tether_io::i32> c,
+    tether_io::u32 m, tether_io::u32 n, tether_io::u32 k_bits,
+    binmatmul_rows_fn rows
+) -> std::expected<void, tether_io::device_error> {
+    const tether_io::u32 k_words = (k_bits + 31u) / 32u;
+
+    if (a_bits.size() != static_cast<tether_io::usize>(m) * k_words ||
+        b_bits.size() != static_cast<tether_io::usize>(n) * k_words ||
+        c.size() != static_cast<tether_io::usize>(m) * n) {
+        return std::unexpected(tether_io::device_error::launch_failed);
+    }
+
+    // Degenerate K, every dot product is empty
+    if (k_words == 0u) {
+        std::fill(c.begin(), c.end(), 0);
+        return {};
+    }
+
+    const tether_io::u32 rem       = (k_bits & 31u);
+    const tether_io::u32 tail_mask = (rem == 0u) ? 0xFFFFFFFFu : ((1u << rem) - 1u);
+
+    rows(a_bits.data(), b_bits.data(), c.data(), m, n, n, k_bits, k_words, tail_mask);
+    return {};
+}
+
+}
+
+namespace tether_io{
+
+auto binmatmul_avx2_cpu_native_standalone(
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    std::span<i32> c,
+    u32 m, u32 n, u32 k_bits
+) -> std::expected<void, device_error> {
+#ifdef TETHER_IO_ARCH_X86_64
+    if (!is_cpu_isa_supported(cpu_isa::avx2)) return std::unexpected(device_error::not_available);
+    return binmatmul_packed_cpu_native(a_bits, b_bits, c, m, n, k_bits, binmatmul_rows_avx2);
+#else
+    (void)a_bits; (void)b_bits; (void)c; (void)m; (void)n; (void)k_bits;
+    return std::unexpected(device_error::not_available);
+#endif
+}
+
+auto binmatmul_avx512_vpopcntdq_cpu_native_standalone(
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    std::span<i32> c,
+    u32 m, u32 n, u32 k_bits
+) -> std::expected<void, device_error> {
+#ifdef TETHER_IO_ARCH_X86_64
+    if (!is_cpu_isa_supported(cpu_isa::avx512_vpopcntdq)) return std::unexpected(device_error::not_available);
+    return binmatmul_packed_cpu_native(a_bits, b_bits, c, m, n, k_bits, binmatmul_rows_avx512);
+#else
+    (void)a_bits; (void)b_bits; (void)c; (void)m; (void)n; (void)k_bits;
+    return std::unexpected(device_error::not_available);
+#endif
+}
+
+auto binmatmul_neon_cpu_native_standalone(
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    std::span<i32> c,
+    u32 m, u32 n, u32 k_bits
+) -> std::expected<void, device_error> {
+#ifdef TETHER_IO_ARCH_ARM64
+    return binmatmul_packed_cpu_native(a_bits, b_bits, c, m, n, k_bits, binmatmul_rows_neon);
+#else
+    (void)a_bits; (void)b_bits; (void)c; (void)m; (void)n; (void)k_bits;
+    return std::unexpected(device_error::not_available);
+#endif
+}
+
+// Runs the requested variant, the scalar reference stays the source of truth for all of them.
+auto binmatmul_isa_cpu_native_standalone(
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    std::span<i32> c,
+    u32 m, u32 n, u32 k_bits,
+    cpu_isa isa
+) -> std::expected<void, device_error> {
+    switch (isa) {
+        case cpu_isa::scalar:           return binmatmul_cpu_native_standalone(a_bits, b_bits, c, m, n, k_bits);
+        case cpu_isa::avx2:             return binmatmul_avx2_cpu_native_standalone(a_bits, b_bits, c, m, n, k_bits);
+        case cpu_isa::avx512_vpopcntdq: return binmatmul_avx512_vpopcntdq_cpu_native_standalone(a_bits, b_bits, c, m, n, k_bits);
+        case cpu_isa::neon:             return binmatmul_neon_cpu_native_standalone(a_bits, b_bits, c, m, n, k_bits);
+        default: return std::unexpected(device_error::not_available);
+    }
+}
+
+auto binmatmul_avx2_cpu_native_standalone(
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    u32 m, u32 n, u32 k_bits
+) -> std::expected<std::vector<i32>, device_error> {
+    std::vector<i32> c(static_cast<usize>(m) * n);
+
+    auto res = binmatmul_avx2_cpu_native_standalone(a_bits, b_bits, c, m, n, k_bits);
+    if (!res.has_value()) return std::unexpected(res.error());
+    return c;
+}
+
+auto binmatmul_avx512_vpopcntdq_cpu_native_standalone(
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    u32 m, u32 n, u32 k_bits
+) -> std::expected<std::vector<i32>, device_error> {
+    std::vector<i32> c(static_cast<usize>(m) * n);
+
+    auto res = binmatmul_avx512_vpopcntdq_cpu_native_standalone(a_bits, b_bits, c, m, n, k_bits);
+    if (!res.has_value()) return std::unexpected(res.error());
+    return c;
+}
+
+auto binmatmul_neon_cpu_native_standalone(
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    u32 m, u32 n, u32 k_bits
+) -> std::expected<std::vector<i32>, device_error> {
+    std::vector<i32> c(static_cast<usize>(m) * n);
+
+    auto res = binmatmul_neon_cpu_native_standalone(a_bits, b_bits, c, m, n, k_bits);
+    if (!res.has_value()) return std::unexpected(res.error());
+    return c;
+}
+
+auto binmatmul_isa_cpu_native_standalone(
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    u32 m, u32 n, u32 k_bits,
+    cpu_isa isa
+) -> std::expected<std::vector<i32>, device_error> {
+    std::vector<i32> c(static_cast<usize>(m) * n);
+
+    auto res = binmatmul_isa_cpu_native_standalone(a_bits, b_bits, c, m, n, k_bits, isa);
+    if (!res.has_value()) return std::unexpected(res.error());
+    return c;
+}
+
+} // tether_io
+
+namespace tether_io{
+
+// Pack buffers of the blocked engine. They only ever grow, so reusing one workspace across calls of the
+// same (or smaller) shape does not touch the heap after the first call.
+struct cpu_gemm_workspace {
+    std::vector<u64> a_packed;
+    std::vector<u64> b_packed;
+};
+
+} // tether_io
+
+namespace {
+
+// Packed GEMM engine, structured like BLIS:
+//
+//   for jc in N step nc            pack B[jc:+nc, pc:+kc] into NR-row micro-panels  (L3)
+//     for pc in K step kc
+//       for ic in M step mc        pack A[ic:+mc, pc:+kc] into MR-row micro-panels  (L2)
+//         for jr, ir               MR x NR micro-kernel over kc words                (L1 + registers)
+//
+// Panels hold 64-bit words with the tail bits of K cleared in both A and B and zero padding up to the
+// vector width, so the micro-kernel counts popcount(a ^ b) without any masking. Mismatch counts are
+// accumulated in C and converted to the {-1,+1} dot product once all K blocks are done.
+
+constexpr tether_io::u32 gemm_mr = 4u;
+constexpr tether_io::u32 gemm_nr = 4u;
+
+// Micro-kernel: out[i * NR + j] = sum over kv of popcount(A_panel[kv][i] ^ B_panel[kv][j]),
+// where every panel step holds `VW` consecutive 64-bit words for each of the MR (NR) rows.
+using gemm_micro_kernel_fn = void (*)(
+    const tether_io::u64*, const tether_io::u64*, tether_io::u32, tether_io::u32*
+);
+
+#ifdef TETHER_IO_ARCH_X86_64
+TETHER_IO_TARGET("popcnt")
+#endif
+static auto gemm_micro_kernel_scalar(
+    const tether_io::u64* a, const tether_io::u64* b, tether_io::u32 steps, tether_io::u32* out
+) -> void {
+    tether_io::u64 acc[gemm_mr][gemm_nr]{};
+
+    for (tether_io::u32 kv = 0; kv < steps; ++kv) {
+        const tether_io::u64* a_step = a + static_cast<tether_io::usize>(kv) * gemm_mr;
+        const tether_io::u64* b_step = b + static_cast<tether_io::usize>(kv) * gemm_nr;
+
+        for (tether_io::u32 i = 0; i < gemm_mr; ++i) {
+            for (tether_io::u32 j = 0; j < gemm_nr; ++j) {
+                acc[i][j] += static_cast<tether_io::u64>(std::popcount(a_step[i] ^ b_step[j]));
+            }
+        }
+    }
+
+    for (tether_io::u32 i = 0; i < gemm_mr; ++i) {
+        for (tether_io::u32 j = 0; j < gemm_nr; ++j) {
+            out[i * gemm_nr + j] = static_cast<tether_io::u32>(acc[i][j]);
+        }
+    }
+}
+
+#ifdef TETHER_IO_ARCH_X86_64
+
+// AVX2 only has 16 ymm registers, so the 4 x 4 tile is computed as two 2 x 4 halves. Popcounts are
+// kept as per-byte counts (at most 8 per step) and folded with vpsadbw every 31 steps before they overflow.
+TETHER_IO_TARGET_AVX2 static auto gemm_micro_kernel_avx2(
+    const tether_io::u64* a, const tether_io::u64* b, tether_io::u32 steps, tether_io::u32* out
+) -> void {
+    constexpr tether_io::u32 vw = 4u;
+    constexpr tether_io::u32 half = gemm_mr / 2u;
+    constexpr tether_io::u32 flush_steps = 31u;
+
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+    );
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+
+    for (tether_io::u32 i0 = 0; i0 < gemm_mr; i0 += half) {
+        __m256i sums[half][gemm_nr];
+        for (auto& row : sums) for (auto& v : row) v = _mm256_setzero_si256();
+
+        for (tether_io::u32 kv0 = 0; kv0 < steps; kv0 += flush_steps) {
+            const tether_io::u32 kv_end = std::min(steps, kv0 + flush_steps);
+
+            __m256i bytes[half][gemm_nr];
+            for (auto& row : bytes) for (auto& v : row) v = _mm256_setzero_si256();
+
+            for (tether_io::u32 kv = kv0; kv < kv_end; ++kv) {
+                const tether_io::u64* a_step = a + static_cast<tether_io::usize>(kv) * gemm_mr * vw;
+                const tether_io::u64* b_step = b + static_cast<tether_io::usize>(kv) * gemm_nr * vw;
+
+                __m256i av[half];
+                for (tether_io::u32 i = 0; i < half; ++i) {
+                    av[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_step + (i0 + i) * vw));
+                }
+
+                for (tether_io::u32 j = 0; j < gemm_nr; ++j) {
+                    const __m256i bv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b_step + j * vw));
+                    for (tether_io::u32 i = 0; i < half; ++i) {
+                        const __m256i x  = _mm256_xor_si256(av[i], bv);
+                        const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(x, low_mask));
+                        const __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(x, 4), low_mask));
+                        bytes[i][j] = _mm256_add_epi8(bytes[i][j], _mm256_add_epi8(lo, hi));
+                    }
+                }
+            }
+
+            for (tether_io::u32 i = 0; i < half; ++i) {
+                for (tether_io::u32 j = 0; j < gemm_nr; ++j) {
+                    sums[i][j] = _mm256_add_epi64(sums[i][j], _mm256_sad_epu8(bytes[i][j], _mm256_setzero_si256()));
+                }
+            }
+        }
+
+        for (tether_io::u32 i = 0; i < half; ++i) {
+            for (tether_io::u32 j = 0; j < gemm_nr; ++j) {
+                out[(i0 + i) * gemm_nr + j] = static_cast<tether_io::u32>(
+                    _mm256_extract_epi64(sums[i][j], 0) + _mm256_extract_epi64(sums[i][j], 1) +
+                    _mm256_extract_epi64(sums[i][j], 2) + _mm256_extract_epi64(sums[i][j], 3)
+                );
+            }
+        }
+    }
+}
+
+TETHER_IO_TARGET_AVX512_VPOPCNTDQ static auto gemm_micro_kernel_avx512(
+    const tether_io::u64* a, const tether_io::u64* b, tether_io::u32 steps, tether_io::u32* out
+) -> void {
+    constexpr tether_io::u32 vw = 8u;
+    __m512i acc[gemm_mr][gemm_nr];
+    for (auto& row : acc) for (auto& v : row) v = _mm512_setzero_si512();
+
+    for (tether_io::u32 kv = 0; kv < steps; ++kv) {
+        const tether_io::u64* a_step = a + static_cast<tether_io::usize>(kv) * gemm_mr * vw;
+        const tether_io::u64* b_step = b + static_cast<tether_io::usize>(kv) * gemm_nr * vw;
+
+        __m512i av[gemm_mr];
+        for (tether_io::u32 i = 0; i < gemm_mr; ++i) {
+            av[i] = _mm512_loadu_si512(a_step + i * vw);
+        }
+
+        for (tether_io::u32 j = 0; j < gemm_nr; ++j) {
+            const __m512i bv = _mm512_loadu_si512(b_step + j * vw);
+            for (tether_io::u32 i = 0; i < gemm_mr; ++i) {
+                acc[i][j] = _mm512_add_epi64(acc[i][j], _mm512_popcnt_epi64(_mm512_xor_si512(av[i], bv)));
+            }
+        }
+    }
+
+    for (tether_io::u32 i = 0; i < gemm_mr; ++i) {
+        for (tether_io::u32 j = 0; j < gemm_nr; ++j) {
+            out[i * gemm_nr + j] = static_cast<tether_io::u32>(_mm512_reduce_add_epi64(acc[i][j]));
+        }
+    }
+}
+
+#endif // TETHER_IO_ARCH_X86_64
+
+struct gemm_micro_kernel {
+    gemm_micro_kernel_fn fn;
+    tether_io::u32 vw; // 64-bit words per panel row and step
+};
+
+static inline auto select_gemm_micro_kernel(tether_io::cpu_isa isa) -> gemm_micro_kernel {
+    switch (isa) {
+#ifdef TETHER_IO_ARCH_X86_64
+        case tether_io::cpu_isa::avx2:             return { gemm_micro_kernel_avx2, 4u };
+        case tether_io::cpu_isa::avx512_vpopcntdq: return { gemm_micro_kernel_avx512, 8u };
+#endif
+        default:                                   return { gemm_micro_kernel_scalar, 1u };
+    }
+}
+
+// 64-bit word `w` of a packed u32 row, with the bits past k_bits cleared
+static inline auto packed_row_word64(
+    const tether_io::u32* row, tether_io::u32 w, tether_io::u32 k_words, tether_io::u32 tail_mask
+) -> tether_io::u64 {
+    const tether_io::u32 lo_idx = 2u * w;
+    const tether_io::u32 hi_idx = lo_idx + 1u;
+
+    tether_io::u64 lo = (lo_idx < k_words) ? row[lo_idx] : 0u;
+    tether_io::u64 hi = (hi_idx < k_words) ? row[hi_idx] : 0u;
+    if (lo_idx + 1u == k_words) lo &= tail_mask;
+    if (hi_idx + 1u == k_words) hi &= tail_mask;
+
+    return lo | (hi << 32);
+}
+
+// Packs rows [row0, row0 + rows) and 64-bit words [w0, w0 + kc) into micro-panels of `mr` rows:
+//   panel[p][kv][i][lane] = src[row0 + p * mr + i][w0 + kv * vw + lane]
+// Rows past `rows` and words past the matrix are zero so they never contribute mismatches.
+static inline auto gemm_pack_panels(
+    const tether_io::u32* src, tether_io::u32 k_words, tether_io::u32 tail_mask, tether_io::u32 total_w64,
+    tether_io::u32 row0, tether_io::u32 rows, tether_io::u32 w0, tether_io::u32 kc_padded,
+    tether_io::u32 mr, tether_io::u32 vw, tether_io::u64* dst
+) -> void {
+    const tether_io::u32 panels = (rows + mr - 1u) / mr;
+    const tether_io::u32 steps  = kc_padded / vw;
+
+    for (tether_io::u32 p = 0; p < panels; ++p) {
+        tether_io::u64* panel = dst + static_cast<tether_io::usize>(p) * kc_padded * mr;
+
+        for (tether_io::u32 i = 0; i < mr; ++i) {
+            const tether_io::u32 r = p * mr + i;
+            const tether_io::u32* row = src + static_cast<tether_io::usize>(row0 + r) * k_words;
+
+            for (tether_io::u32 kv = 0; kv < steps; ++kv) {
+                tether_io::u64* out = panel + (static_cast<tether_io::usize>(kv) * mr + i) * vw;
+                for (tether_io::u32 lane = 0; lane < vw; ++lane) {
+                    const tether_io::u32 w = w0 + kv * vw + lane;
+                    out[lane] = (r < rows && w < total_w64) ? packed_row_word64(row, w, k_words, tail_mask) : 0u;
+                }
+            }
+        }
+    }
+}
+
+static inline auto round_up(tether_io::u32 value, tether_io::u32 multiple) -> tether_io::u32 {
+    return ((value + multiple - 1u) / multiple) * multiple;
+}
+
+static auto binmatmul_blocked_rows(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::i32* c,
+    tether_io::u32 m, tether_io::u32 n, tether_io::u32 k_bits,
+    tether_io::cpu_gemm_blocking blocking, gemm_micro_kernel micro, tether_io::cpu_gemm_workspace& workspace
+) -> void {
+    const tether_io::u32 k_words   = (k_bits + 31u) / 32u;
+    const tether_io::u32 total_w64 = (k_words + 1u) / 2u;
+    const tether_io::u32 rem       = (k_bits & 31u);
+    const tether_io::u32 tail_mask = (rem == 0u) ? 0xFFFFFFFFu : ((1u << rem) - 1u);
+
+    // Block sizes are rounded to whole micro-panels / vector steps
+    const tether_io::u32 mc = round_up(std::max(blocking.mc, 1u), gemm_mr);
+    const tether_io::u32 nc = round_up(std::max(blocking.nc, 1u), gemm_nr);
+    const tether_io::u32 kc = round_up(std::max(blocking.kc, 1u), micro.vw);
+
+    // Pack buffers only need to cover the problem when it is smaller than one block
+    const tether_io::usize a_pack_words = static_cast<tether_io::usize>(std::min(mc, round_up(m, gemm_mr))) * std::min(kc, round_up(total_w64, micro.vw));
+    const tether_io::usize b_pack_words = static_cast<tether_io::usize>(std::min(nc, round_up(n, gemm_nr))) * std::min(kc, round_up(total_w64, micro.vw));
+
+    if (workspace.a_packed.size() < a_pack_words) workspace.a_packed.resize(a_pack_words);
+    if (workspace.b_packed.size() < b_pack_words) workspace.b_packed.resize(b_pack_words);
+    tether_io::u64* a_packed = workspace.a_packed.data();
+    tether_io::u64* b_packed = workspace.b_packed.data();
+    tether_io::u32 tile[gemm_mr * gemm_nr];
+
+    std::fill(c, c + static_cast<tether_io::usize>(m) * n, 0);
+
+    for (tether_io::u32 jc = 0; jc < n; jc += nc) {
+        const tether_io::u32 nc_eff = std::min(nc, n - jc);
+
+        for (tether_io::u32 pc = 0; pc < total_w64; pc += kc) {
+            const tether_io::u32 kc_eff    = std::min(kc, total_w64 - pc);
+            const tether_io::u32 kc_padded = round_up(kc_eff, micro.vw);
+            const tether_io::u32 steps     = kc_padded / micro.vw;
+
+            gemm_pack_panels(b, k_words, tail_mask, total_w64, jc, nc_eff, pc, kc_padded, gemm_nr, micro.vw, b_packed);
+
+            for (tether_io::u32 ic = 0; ic < m; ic += mc) {
+                const tether_io::u32 mc_eff = std::min(mc, m - ic);
+
+                gemm_pack_panels(a, k_words, tail_mask, total_w64, ic, mc_eff, pc, kc_padded, gemm_mr, micro.vw, a_packed);
+
+                for (tether_io::u32 jr = 0; jr < nc_eff; jr += gemm_nr) {
+                    const tether_io::u64* b_panel = b_packed + static_cast<tether_io::usize>(jr) * kc_padded;
+                    const tether_io::u32 nr_eff = std::min(gemm_nr, nc_eff - jr);
+
+                    for (tether_io::u32 ir = 0; ir < mc_eff; ir += gemm_mr) {
+                        const tether_io::u64* a_panel = a_packed + static_cast<tether_io::usize>(ir) * kc_padded;
+                        const tether_io::u32 mr_eff = std::min(gemm_mr, mc_eff - ir);
+
+                        micro.fn(a_panel, b_panel, steps, tile);
+
+                        for (tether_io::u32 i = 0; i < mr_eff; ++i) {
+                            tether_io::i32* c_row = c + static_cast<tether_io::usize>(ic + ir + i) * n + jc + jr;
+                            for (tether_io::u32 j = 0; j < nr_eff; ++j) {
+                                c_row[j] += static_cast<tether_io::i32>(tile[i * gemm_nr + j]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Mismatch counts -> {-1,+1} dot product
+    for (tether_io::usize i = 0; i < static_cast<tether_io::usize>(m) * n; ++i) {
+        c[i] = static_cast<tether_io::i32>(k_bits) - 2 * c[i];
+    }
+}
+
+}
+
+namespace tether_io{
+
+// Cache-blocked, register-tiled binmatmul. Same inputs and results as binmatmul_cpu_native_standalone,
+// but A and B are streamed through L1/L2/L3 sized packed blocks, which keeps throughput flat once
+// N * k_words no longer fits in cache.
+auto binmatmul_blocked_cpu_native_standalone(
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    std::span<i32> c,
+    u32 m, u32 n, u32 k_bits,
+    cpu_gemm_blocking blocking,
+    cpu_gemm_workspace& workspace,
+    cpu_isa isa
+) -> std::expected<void, device_error> {
+    const u32 k_words = (k_bits + 31u) / 32u;
+
+    if (a_bits.size() != static_cast<usize>(m) * k_words || b_bits.size() != static_cast<usize>(n) * k_words ||
+        c.size() != static_cast<usize>(m) * n) {
+        return std::unexpected(device_error::launch_failed);
+    }
+
+    if (!is_cpu_isa_supported(isa)) return std::unexpected(device_error::not_available);
+
+    if (k_words == 0u) {
+        std::fill(c.begin(), c.end(), 0);
+        return {};
+    }
+
+    binmatmul_blocked_rows(a_bits.data(), b_bits.data(), c.data(), m, n, k_bits, blocking, select_gemm_micro_kernel(isa), workspace);
+    return {};
+}
+
+auto binmatmul_blocked_cpu_native_standalone(
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    u32 m, u32 n, u32 k_bits,
+    cpu_gemm_blocking blocking,
+    cpu_isa isa
+) -> std::expected<std::vector<i32>, device_error> {
+    std::vector<i32> c(static_cast<usize>(m) * n);
+    cpu_gemm_workspace workspace;
+
+    auto res = binmatmul_blocked_cpu_native_standalone(a_bits, b_bits, c, m, n, k_bits, blocking, workspace, isa);
+    if (!res.has_value()) return std::unexpected(res.error());
+    return c;
+}
+
+} // tether_io
+
+namespace tether_io{
+
+// Splits C into tile_size.y x tile_size.x tiles (rows x columns, matching the Vulkan local size
+// convention) and spreads them over the work-stealing pool. Each tile runs the row kernel of `isa`, the
+// B rows of a tile stay cache resident while its A rows stream past them.
+auto binmatmul_parallel_cpu_native_standalone(
+    cpu_thread_pool& pool,
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    std::span<i32> c,
+    u32 m, u32 n, u32 k_bits,
+    vec2<u32> tile_size,
+    cpu_isa isa
+) -> std::expected<void, device_error> {
+    const u32 k_words = (k_bits + 31u) / 32u;
+
+    if (a_bits.size() != static_cast<usize>(m) * k_words || b_bits.size() != static_cast<usize>(n) * k_words ||
+        c.size() != static_cast<usize>(m) * n) {
+        return std::unexpected(device_error::launch_failed);
+    }
+
+    if (tile_size.x == 0 || tile_size.y == 0) return std::unexpected(device_error::launch_failed);
+    if (!is_cpu_isa_supported(isa)) return std::unexpected(device_error::not_available);
+
+    if (k_words == 0u) {
+        std::fill(c.begin(), c.end(), 0);
+        return {};
+    }
+
+    const u32 rem       = (k_bits & 31u);
+    const u32 tail_mask = (rem == 0u) ? 0xFFFFFFFFu : ((1u << rem) - 1u);
+    const binmatmul_rows_fn rows = select_binmatmul_rows(isa);
+
+    const u32 tiles_x = (n + tile_size.x - 1u) / tile_size.x;
+    const u32 tiles_y = (m + tile_size.y - 1u) / tile_size.y;
+
+    const u32* a = a_bits.data();
+    const u32* b = b_bits.data();
+    i32* c_out = c.data();
+
+    pool.parallel_for(static_cast<usize>(tiles_x) * tiles_y, [&](usize task, usize) {
+        const u32 r0 = static_cast<u32>(task / tiles_x) * tile_size.y;
+        const u32 c0 = static_cast<u32>(task % tiles_x) * tile_size.x;
+        const u32 rows_eff = std::min(tile_size.y, m - r0);
+        const u32 cols_eff = std::min(tile_size.x, n - c0);
+
+        rows(
+            a + static_cast<usize>(r0) * k_words,
+            b + static_cast<usize>(c0) * k_words,
+            c_out + static_cast<usize>(r0) * n + c0,
+            rows_eff, cols_eff, n,
+            k_bits, k_words, tail_mask
+        );
+    });
+
+    return {};
+}
+
+auto binmatmul_parallel_cpu_native_standalone(
+    cpu_thread_pool& pool,
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    u32 m, u32 n, u32 k_bits,
+    vec2<u32> tile_size,
+    cpu_isa isa
+) -> std::expected<std::vector<i32>, device_error> {
+    std::vector<i32> c(static_cast<usize>(m) * n);
+
+    auto res = binmatmul_parallel_cpu_native_standalone(pool, a_bits, b_bits, c, m, n, k_bits, tile_size, isa);
+    if (!res.has_value()) return std::unexpected(res.error());
+    return c;
+}
+
+// GEMV-shaped binmatmul for decode, where m is the handful of tokens in flight (usually one). The 2D
+// tiles and packed panels of the GEMM paths are sized for large m and re-read B from L2 once per row of
+// A. Here B is streamed from memory exactly once in blocks of eight rows that are reduced against all m
+// rows of A while they sit in L1, and N is split over the pool in column chunks.
+// Any m is accepted, but only m <= binmatmul_gemv_max_rows beats the tiled paths. Column chunks are
+// multiples of 16 outputs (a cache line of C) to keep false sharing between workers down.
+auto binmatmul_gemv_cpu_native_standalone(
+    cpu_thread_pool& pool,
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    std::span<i32> c,
+    u32 m, u32 n, u32 k_bits,
+    cpu_isa isa
+) -> std::expected<void, device_error> {
+    const u32 k_words = (k_bits + 31u) / 32u;
+
+    if (a_bits.size() != static_cast<usize>(m) * k_words || b_bits.size() != static_cast<usize>(n) * k_words ||
+        c.size() != static_cast<usize>(m) * n) {
+        return std::unexpected(device_error::launch_failed);
+    }
+
+    if (!is_cpu_isa_supported(isa)) return std::unexpected(device_error::not_available);
+
+    if (k_words == 0u) {
+        std::fill(c.begin(), c.end(), 0);
+        return {};
+    }
+
+    const u32 rem       = (k_bits & 31u);
+    const u32 tail_mask = (rem == 0u) ? 0xFFFFFFFFu : ((1u << rem) - 1u);
+    const binmatmul_rows_fn rows = select_binmatmul_rows(isa);
+
+    // A few chunks per worker so stealing can even out the tail, but never below 16 columns
+    const usize target_chunks = pool.thread_count() * 4u;
+    const u32 chunk = std::max<u32>(16u, static_cast<u32>((n / target_chunks + 15u) / 16u * 16u));
+    const u32 chunks = (n + chunk - 1u) / chunk;
+
+    const u32* a = a_bits.data();
+    const u32* b = b_bits.data();
+    i32* c_out = c.data();
+
+    pool.parallel_for(chunks, [&](usize task, usize) {
+        const u32 c0 = static_cast<u32>(task) * chunk;
+        const u32 c1 = std::min(n, c0 + chunk);
+
+        // Eight B rows at a time through the row kernel, they stay in L1 while all m rows of A pass over them
+        for (u32 col = c0; col < c1; col += 8u) {
+            rows(a, b + static_cast<usize>(col) * k_words, c_out + col, m, std::min(8u, c1 - col), n, k_bits, k_words, tail_mask);
+        }
+    });
+
+    return {};
+}
+
+auto binmatmul_gemv_cpu_native_standalone(
+    cpu_thread_pool& pool,
+    std::span<const u32> a_bits,
+    std::span<const u32> b_bits,
+    u32 m, u32 n, u32 k_bits,
+    cpu_isa isa
+) -> std::expected<std::vector<i32>, device_error> {
+    std::vector<i32> c(static_cast<usize>(m) * n);
+
+    auto res = binmatmul_gemv_cpu_native_standalone(pool, a_bits, b_bits, c, m, n, k_bits, isa);
+    if (!res.has_value()) return std::unexpected(res.error());
     return c;
 }
 
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <vector>
+
+#include "../../types.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define TETHER_IO_ARCH_X86_64 1
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+    #include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    #define TETHER_IO_ARCH_ARM64 1
+    #include <arm_neon.h>
+#endif
+
+// GCC and Clang only emit AVX2 / AVX-512 instructions inside functions that opt in through the target
+// attribute, MSVC accepts the intrinsics everywhere. This keeps the rest of the binary baseline x86-64.
+#if defined(__GNUC__) || defined(__clang__)
+    #define TETHER_IO_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define TETHER_IO_TARGET(isa)
+#endif
+
+#define TETHER_IO_TARGET_AVX2 TETHER_IO_TARGET("avx2,popcnt")
+#define TETHER_IO_TARGET_AVX512_VPOPCNTDQ TETHER_IO_TARGET("avx512f,avx512vpopcntdq,popcnt")
+
+namespace tether_io{
+
+struct cpu_features {
+    bool avx2 { false };
+    bool avx512_vpopcntdq { false };
+    bool neon { false };
+};
+
+namespace {
+
+#ifdef TETHER_IO_ARCH_X86_64
+
+static inline auto cpuid(tether_io::u32 leaf, tether_io::u32 sub_leaf, tether_io::u32 (&regs)[4]) -> void {
+#if defined(_MSC_VER)
+    int out[4];
+    __cpuidex(out, static_cast<int>(leaf), static_cast<int>(sub_leaf));
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<tether_io::u32>(out[i]);
+#else
+    __cpuid_count(leaf, sub_leaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// XCR0 tells which register states the OS saves on a context switch, the cpuid bits alone are not enough.
+static inline auto xgetbv0() -> tether_io::u64 {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    tether_io::u32 lo = 0, hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<tether_io::u64>(hi) << 32) | lo;
+#endif
+}
+
+static inline auto query_cpu_features() -> tether_io::cpu_features {
+    tether_io::cpu_features out{};
+    tether_io::u32 regs[4]{};
+
+    cpuid(0, 0, regs);
+    const tether_io::u32 max_leaf = regs[0];
+    if (max_leaf < 7) return out;
+
+    cpuid(1, 0, regs);
+    const bool osxsave = (regs[2] >> 27) & 1u;
+    const bool popcnt  = (regs[2] >> 23) & 1u;
+    if (!osxsave || !popcnt) return out;
+
+    const tether_io::u64 xcr0 = xgetbv0();
+    const bool os_avx    = (xcr0 & 0x6u) == 0x6u;   // XMM + YMM state
+    const bool os_avx512 = (xcr0 & 0xE6u) == 0xE6u; // XMM + YMM + opmask + ZMM state
+
+    cpuid(7, 0, regs);
+    out.avx2 = os_avx && ((regs[1] >> 5) & 1u);
+    out.avx512_vpopcntdq = os_avx512 && ((regs[1] >> 16) & 1u) && ((regs[2] >> 14) & 1u);
+
+    return out;
+}
+
+#else
+
+static inline auto query_cpu_features() -> tether_io::cpu_features {
+    tether_io::cpu_features out{};
+#ifdef TETHER_IO_ARCH_ARM64
+    out.neon = true; // Advanced SIMD is mandatory on AArch64
+#endif
+    return out;
+}
+
+#endif // TETHER_IO_ARCH_X86_64
+
+}
+
+// Features are probed once per process, the result never changes while running.
+auto detect_cpu_features() -> const cpu_features& {
+    static const cpu_features features = query_cpu_features();
+    return features;
+}
+
+auto is_cpu_isa_supported(cpu_isa isa) -> bool {
+    const auto& features = detect_cpu_features();
+    switch (isa) {
+        case cpu_isa::scalar:           return true;
+        case cpu_isa::avx2:             return features.avx2;
+        case cpu_isa::avx512_vpopcntdq: return features.avx512_vpopcntdq;
+        case cpu_isa::neon:             return features.neon;
+        default: return false;
+    }
+}
+
+// Widest instruction set available on this machine, used when the caller does not pick one.
+auto best_cpu_isa() -> cpu_isa {
+    if (is_cpu_isa_supported(cpu_isa::avx512_vpopcntdq)) return cpu_isa::avx512_vpopcntdq;
+    if (is_cpu_isa_supported(cpu_isa::avx2)) return cpu_isa::avx2;
+    if (is_cpu_isa_supported(cpu_isa::neon)) return cpu_isa::neon;
+    return cpu_isa::scalar;
+}
+
+auto supported_cpu_isas() -> std::vector<cpu_isa> {
+    std::vector<cpu_isa> out;
+    for (auto isa : {cpu_isa::scalar, cpu_isa::avx2, cpu_isa::avx512_vpopcntdq, cpu_isa::neon}) {
+        if (is_cpu_isa_supported(isa)) out.push_back(isa);
+    }
+    return out;
+}
+
+} // tether_io
@@ -1,29 +1,35 @@
 #pragma once
 
+#include <algorithm>
 #include <expected>
 #include <span>
-#include <random>
+#include <vector>
 
 #include "../../types.hpp"
+#include "cpu_features.hpp"
+#include "thread_pool.hpp"
 
 namespace tether_io{
 
 // A is row-major [matrix_side x k_bits] with values in { -1, +1 } (or any float; >=0 -> bit 1)
 // Output: row-major bit-pack along K => [matrix_side x k_words]
+// The span overloads of every packer and generator write into caller memory of exactly the output size
+// and never allocate, the vector-returning overloads allocate the output and forward to them.
 auto f32_mat_to_packed_u32_row_major_cpu_native_standalone(
-    std::span<f32> in,
+    std::span<const f32> in,
+    std::span<u32> out,
     u32 matrix_side,
     u32 k_bits
-) -> std::expected<std::vector<u32>, device_error> {
+) -> std::expected<void, device_error> {
     const u32 k_words = (k_bits + 31u) / 32u;
 
     // Expect exactly matrix_side * k_bits input scalars
-    if(in.size() != static_cast<usize>(matrix_side) * static_cast<usize>(k_bits)){
+    if(in.size() != static_cast<usize>(matrix_side) * static_cast<usize>(k_bits) ||
+       out.size() != static_cast<usize>(matrix_side) * k_words){
         return std::unexpected{ device_error::launch_failed };
     }
 
-    std::vector<u32> out;
-    out.assign(static_cast<usize>(matrix_side) * k_words, 0u);
+    std::fill(out.begin(), out.end(), 0u);
 
     for (u32 r = 0; r < matrix_side; ++r) {
         const usize row_off_in  = static_cast<usize>(r) * k_bits;
@@ -36,6 +42,18 @@ auto f32_mat_to_packed_u32_row_major_cpu_native_standalone(
             out[row_off_out + kw] |= (bit << off);
         }
     }
+    return {};
+}
+
+auto f32_mat_to_packed_u32_row_major_cpu_native_standalone(
+    std::span<const f32> in,
+    u32 matrix_side,
+    u32 k_bits
+) -> std::expected<std::vector<u32>, device_error> {
+    std::vector<u32> out(static_cast<usize>(matrix_side) * ((k_bits + 31u) / 32u));
+
+    auto res = f32_mat_to_packed_u32_row_major_cpu_native_standalone(in, out, matrix_side, k_bits);
+    if (!res.has_value()) return std::unexpected{ res.error() };
     return out;
 }
 
@@ -44,18 +62,19 @@ auto f32_mat_to_packed_u32_row_major_cpu_native_standalone(
 // We pack "columns as matrix_side": each original column becomes one packed row
 // Output: [matrix_side x k_words]
 auto f32_mat_to_packed_u32_col_major_cpu_native_standalone(
-    std::span<f32> in,
+    std::span<const f32> in,
+    std::span<u32> out,
     u32 matrix_side,
     u32 k_bits
-) -> std::expected<std::vector<u32>, device_error> {
+) -> std::expected<void, device_error> {
     const u32 k_words = (k_bits + 31u) / 32u;
     // Expect exactly k_bits * matrix_side input scalars
-    if(in.size() != static_cast<usize>(k_bits) * static_cast<usize>(matrix_side)){
+    if(in.size() != static_cast<usize>(k_bits) * static_cast<usize>(matrix_side) ||
+       out.size() != static_cast<usize>(matrix_side) * k_words){
         return std::unexpected{ device_error::launch_failed };
     }
 
-    std::vector<u32> out;
-    out.assign(static_cast<usize>(matrix_side) * k_words, 0u);
+    std::fill(out.begin(), out.end(), 0u);
 
     for (u32 c = 0; c < matrix_side; ++c) {
         const usize row_off_out = static_cast<usize>(c) * k_words;
@@ -69,115 +88,836 @@ auto f32_mat_to_packed_u32_col_major_cpu_native_standalone(
             out[row_off_out + kw] |= (bit << off);
         }
     }
+    return {};
+}
+
+auto f32_mat_to_packed_u32_col_major_cpu_native_standalone(
+    std::span<const f32> in,
+    u32 matrix_side,
+    u32 k_bits
+) -> std::expected<std::vector<u32>, device_error> {
+    std::vector<u32> out(static_cast<usize>(matrix_side) * ((k_bits + 31u) / 32u));
+
+    auto res = f32_mat_to_packed_u32_col_major_cpu_native_standalone(in, out, matrix_side, k_bits);
+    if (!res.has_value()) return std::unexpected{ res.error() };
     return out;
 }
 
-// Create a random matrix with binary distribution as floating point representation (-1.f, 1.0f)
-auto random_mat_binary_f32_1d_pm_one_dist_cpu_native_standalone(
-    u32 rows, u32 cols, u32 seed
-) -> std::expected<std::vector<f32>, device_error> {
-    if (rows == 0 || cols == 0){
-        return std::unexpected{ device_error::launch_failed };
+namespace {
+
+// Packs up to 32 floats into one word, bit i = (src[i] >= 0). Used for tails and as the scalar variant.
+static inline auto pack_signs_scalar(const tether_io::f32* src, tether_io::u32 count) -> tether_io::u32 {
+    tether_io::u32 word = 0u;
+    for (tether_io::u32 i = 0; i < count; ++i) {
+        word |= (src[i] >= 0.0f ? 1u : 0u) << i;
     }
+    return word;
+}
+
+static inline auto pack_signs32_scalar(const tether_io::f32* src) -> tether_io::u32 {
+    return pack_signs_scalar(src, 32u);
+}
+
+// The SIMD packers compare against zero (ordered, non-signalling) before extracting the mask instead of
+// reading the raw sign bit, so -0.0f still packs to 1 and NaN to 0 exactly like the scalar reference.
+#ifdef TETHER_IO_ARCH_X86_64
+
+TETHER_IO_TARGET_AVX2
+static auto pack_signs32_avx2(const tether_io::f32* src) -> tether_io::u32 {
+    const __m256 zero = _mm256_setzero_ps();
+    tether_io::u32 word = 0u;
+    for (int q = 0; q < 4; ++q) {
+        const __m256 ge = _mm256_cmp_ps(_mm256_loadu_ps(src + 8 * q), zero, _CMP_GE_OQ);
+        word |= static_cast<tether_io::u32>(_mm256_movemask_ps(ge)) << (8 * q);
+    }
+    return word;
+}
+
+TETHER_IO_TARGET_AVX512_VPOPCNTDQ
+static auto pack_signs32_avx512(const tether_io::f32* src) -> tether_io::u32 {
+    const __m512 zero = _mm512_setzero_ps();
+    const __mmask16 lo = _mm512_cmp_ps_mask(_mm512_loadu_ps(src), zero, _CMP_GE_OQ);
+    const __mmask16 hi = _mm512_cmp_ps_mask(_mm512_loadu_ps(src + 16), zero, _CMP_GE_OQ);
+    return static_cast<tether_io::u32>(lo) | (static_cast<tether_io::u32>(hi) << 16);
+}
 
-    std::vector<f32> out;
+#endif // TETHER_IO_ARCH_X86_64
 
-    std::mt19937 rng(seed); 
-    std::uniform_int_distribution<i32> d(0,1);
-    
-    out.resize(static_cast<usize>(rows) * cols);
+#ifdef TETHER_IO_ARCH_ARM64
 
-    for (usize i = 0; i < out.size(); ++i){
-        out[i] = (d(rng) == 1 ? 1.0f : -1.0f);
+static auto pack_signs32_neon(const tether_io::f32* src) -> tether_io::u32 {
+    // NEON has no movemask, weight each lane mask with its bit and sum across the vector
+    static const tether_io::u32 lane_bits[4] = {1u, 2u, 4u, 8u};
+    const uint32x4_t weights = vld1q_u32(lane_bits);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    tether_io::u32 word = 0u;
+    for (int q = 0; q < 8; ++q) {
+        const uint32x4_t ge = vcgeq_f32(vld1q_f32(src + 4 * q), zero);
+        word |= vaddvq_u32(vandq_u32(ge, weights)) << (4 * q);
+    }
+    return word;
+}
+
+#endif // TETHER_IO_ARCH_ARM64
+
+using pack_signs32_fn = tether_io::u32 (*)(const tether_io::f32*);
+
+static inline auto select_pack_signs32(tether_io::cpu_isa isa) -> pack_signs32_fn {
+    switch (isa) {
+#ifdef TETHER_IO_ARCH_X86_64
+        case tether_io::cpu_isa::avx2:             return pack_signs32_avx2;
+        case tether_io::cpu_isa::avx512_vpopcntdq: return pack_signs32_avx512;
+#endif
+#ifdef TETHER_IO_ARCH_ARM64
+        case tether_io::cpu_isa::neon:             return pack_signs32_neon;
+#endif
+        default:                                   return pack_signs32_scalar;
     }
+}
 
+// In-place transpose of a 32x32 bit matrix, bit c of m[r] is element (r, c).
+// Swaps the off-diagonal 16x16 blocks, then the 8x8 blocks inside each of those and so on (Hacker's Delight 7-3).
+static inline auto transpose_bits32(tether_io::u32 (&m)[32]) -> void {
+    tether_io::u32 mask = 0x0000FFFFu;
+    for (tether_io::u32 j = 16u; j != 0u; j >>= 1, mask ^= (mask << j)) {
+        for (tether_io::u32 k = 0; k < 32u; k = (k + j + 1u) & ~j) {
+            const tether_io::u32 t = ((m[k] >> j) ^ m[k + j]) & mask;
+            m[k]     ^= (t << j);
+            m[k + j] ^= t;
+        }
+    }
+}
+
+static auto f32_mat_to_packed_u32_row_major(
+    std::span<const tether_io::f32> in, std::span<tether_io::u32> out,
+    tether_io::u32 matrix_side, tether_io::u32 k_bits, pack_signs32_fn pack32
+) -> void {
+    const tether_io::u32 k_words = (k_bits + 31u) / 32u;
+    const tether_io::u32 full_words = k_bits / 32u;
+
+    for (tether_io::u32 r = 0; r < matrix_side; ++r) {
+        const tether_io::f32* src = in.data() + static_cast<tether_io::usize>(r) * k_bits;
+        tether_io::u32* dst = out.data() + static_cast<tether_io::usize>(r) * k_words;
+
+        for (tether_io::u32 kw = 0; kw < full_words; ++kw) dst[kw] = pack32(src + 32u * kw);
+        if (full_words != k_words) dst[full_words] = pack_signs_scalar(src + 32u * full_words, k_bits & 31u);
+    }
+}
+
+// Works on 32 (k) x 32 (column) tiles: every K row of the tile is one sequential 128-byte read packed
+// along the columns, the bit transpose then turns those row masks into one K word per column.
+static auto f32_mat_to_packed_u32_col_major(
+    std::span<const tether_io::f32> in, std::span<tether_io::u32> out,
+    tether_io::u32 matrix_side, tether_io::u32 k_bits, pack_signs32_fn pack32
+) -> void {
+    const tether_io::u32 k_words = (k_bits + 31u) / 32u;
+
+    tether_io::u32 tile[32];
+    for (tether_io::u32 kw = 0; kw < k_words; ++kw) {
+        const tether_io::u32 k0 = 32u * kw;
+        const tether_io::u32 k_eff = std::min(32u, k_bits - k0);
+
+        for (tether_io::u32 c0 = 0; c0 < matrix_side; c0 += 32u) {
+            const tether_io::u32 c_eff = std::min(32u, matrix_side - c0);
+
+            for (tether_io::u32 j = 0; j < 32u; ++j) {
+                if (j >= k_eff) { tile[j] = 0u; continue; }
+
+                const tether_io::f32* src = in.data() + static_cast<tether_io::usize>(k0 + j) * matrix_side + c0;
+                tile[j] = (c_eff == 32u) ? pack32(src) : pack_signs_scalar(src, c_eff);
+            }
+
+            transpose_bits32(tile);
+
+            for (tether_io::u32 i = 0; i < c_eff; ++i) {
+                out[static_cast<tether_io::usize>(c0 + i) * k_words + kw] = tile[i];
+            }
+        }
+    }
+}
+
+}
+
+// Same layouts as the two packers above, vectorized for `isa` (cpu_isa::scalar still uses the blocked transpose)
+auto f32_mat_to_packed_u32_row_major_isa_cpu_native_standalone(
+    std::span<const f32> in,
+    std::span<u32> out,
+    u32 matrix_side,
+    u32 k_bits,
+    cpu_isa isa
+) -> std::expected<void, device_error> {
+    if(in.size() != static_cast<usize>(matrix_side) * static_cast<usize>(k_bits) ||
+       out.size() != static_cast<usize>(matrix_side) * ((k_bits + 31u) / 32u)){
+        return std::unexpected{ device_error::launch_failed };
+    }
+    if (!is_cpu_isa_supported(isa)) return std::unexpected{ device_error::not_available };
+
+    f32_mat_to_packed_u32_row_major(in, out, matrix_side, k_bits, select_pack_signs32(isa));
+    return {};
+}
+
+auto f32_mat_to_packed_u32_col_major_isa_cpu_native_standalone(
+    std::span<const f32> in,
+    std::span<u32> out,
+    u32 matrix_side,
+    u32 k_bits,
+    cpu_isa isa
+) -> std::expected<void, device_error> {
+    if(in.size() != static_cast<usize>(k_bits) * static_cast<usize>(matrix_side) ||
+       out.size() != static_cast<usize>(matrix_side) * ((k_bits + 31u) / 32u)){
+        return std::unexpected{ device_error::launch_failed };
+    }
+    if (!is_cpu_isa_supported(isa)) return std::unexpected{ device_error::not_available };
+
+    f32_mat_to_packed_u32_col_major(in, out, matrix_side, k_bits, select_pack_signs32(isa));
+    return {};
+}
+
+auto f32_mat_to_packed_u32_row_major_isa_cpu_native_standalone(
+    std::span<const f32> in,
+    u32 matrix_side,
+    u32 k_bits,
+    cpu_isa isa
+) -> std::expected<std::vector<u32>, device_error> {
+    std::vector<u32> out(static_cast<usize>(matrix_side) * ((k_bits + 31u) / 32u));
+
+    auto res = f32_mat_to_packed_u32_row_major_isa_cpu_native_standalone(in, out, matrix_side, k_bits, isa);
+    if (!res.has_value()) return std::unexpected{ res.error() };
     return out;
 }
 
-auto random_mat_binary_f32_1d_zero_one_dist_cpu_native_standalone(
-    u32 rows, u32 cols, u32 seed
-) -> std::expected<std::vector<f32>, device_error> {
-    if (rows == 0 || cols == 0){
+auto f32_mat_to_packed_u32_col_major_isa_cpu_native_standalone(
+    std::span<const f32> in,
+    u32 matrix_side,
+    u32 k_bits,
+    cpu_isa isa
+) -> std::expected<std::vector<u32>, device_error> {
+    std::vector<u32> out(static_cast<usize>(matrix_side) * ((k_bits + 31u) / 32u));
+
+    auto res = f32_mat_to_packed_u32_col_major_isa_cpu_native_standalone(in, out, matrix_side, k_bits, isa);
+    if (!res.has_value()) return std::unexpected{ res.error() };
+    return out;
+}
+
+// Ternary (1.58-bit) packing. Values are quantized to {-1, 0, +1} by sign, 0.0f, -0.0f and NaN become 0.
+// Every 32 weights of K take two words, stored interleaved so both planes of a step sit side by side:
+//   word 2 * kw     = sign plane,    bit = (v < 0)
+//   word 2 * kw + 1 = nonzero plane, bit = (v != 0)
+// Bits past k_bits are cleared in both planes, the nonzero plane then masks the tail on its own.
+
+namespace {
+
+static inline auto pack_ternary_planes(
+    const tether_io::f32* src, tether_io::u32 count,
+    tether_io::u32& sign, tether_io::u32& nonzero
+) -> void {
+    sign = 0u;
+    nonzero = 0u;
+    for (tether_io::u32 i = 0; i < count; ++i) {
+        const tether_io::f32 v = src[i];
+        sign    |= (v < 0.0f ? 1u : 0u) << i;
+        nonzero |= (v < 0.0f || v > 0.0f ? 1u : 0u) << i;
+    }
+}
+
+}
+
+// A is row-major [matrix_side x k_bits], output: [matrix_side x k_words x 2] (sign, nonzero) pairs
+auto f32_mat_to_packed_ternary_u32_row_major_cpu_native_standalone(
+    std::span<const f32> in,
+    std::span<u32> out,
+    u32 matrix_side,
+    u32 k_bits
+) -> std::expected<void, device_error> {
+    const u32 k_words = (k_bits + 31u) / 32u;
+
+    if(in.size() != static_cast<usize>(matrix_side) * static_cast<usize>(k_bits) ||
+       out.size() != static_cast<usize>(matrix_side) * k_words * 2u){
         return std::unexpected{ device_error::launch_failed };
     }
 
-    std::vector<f32> out;
+    for (u32 r = 0; r < matrix_side; ++r) {
+        const f32* src = in.data() + static_cast<usize>(r) * k_bits;
+        u32* dst = out.data() + static_cast<usize>(r) * k_words * 2u;
+
+        for (u32 kw = 0; kw < k_words; ++kw) {
+            const u32 k0 = 32u * kw;
+            pack_ternary_planes(src + k0, std::min(32u, k_bits - k0), dst[2u * kw], dst[2u * kw + 1u]);
+        }
+    }
+    return {};
+}
+
+// B is row-major [k_bits x matrix_side], every column becomes one packed row: [matrix_side x k_words x 2].
+// Same 32 x 32 tiling as the binary column-major packer, one bit transpose per plane.
+auto f32_mat_to_packed_ternary_u32_col_major_cpu_native_standalone(
+    std::span<const f32> in,
+    std::span<u32> out,
+    u32 matrix_side,
+    u32 k_bits
+) -> std::expected<void, device_error> {
+    const u32 k_words = (k_bits + 31u) / 32u;
+
+    if(in.size() != static_cast<usize>(k_bits) * static_cast<usize>(matrix_side) ||
+       out.size() != static_cast<usize>(matrix_side) * k_words * 2u){
+        return std::unexpected{ device_error::launch_failed };
+    }
 
-    f32 lower_bound = 0.0f;
-    f32 upper_bound = 1.0f;
+    u32 sign_tile[32];
+    u32 nonzero_tile[32];
+    for (u32 kw = 0; kw < k_words; ++kw) {
+        const u32 k0 = 32u * kw;
+        const u32 k_eff = std::min(32u, k_bits - k0);
 
-    // Create random number generator
-    std::random_device rd;  // Seed source (hardware)
-    std::mt19937 gen(rd()); // Mersenne Twister engine
-    std::uniform_real_distribution<f32> dist(lower_bound, upper_bound);
+        for (u32 c0 = 0; c0 < matrix_side; c0 += 32u) {
+            const u32 c_eff = std::min(32u, matrix_side - c0);
 
-    out.resize(static_cast<usize>(rows) * cols);
+            for (u32 j = 0; j < 32u; ++j) {
+                if (j >= k_eff) { sign_tile[j] = 0u; nonzero_tile[j] = 0u; continue; }
 
-    for (usize i = 0; i < out.size(); ++i){
-        out[i] =  dist(gen);
+                const f32* src = in.data() + static_cast<usize>(k0 + j) * matrix_side + c0;
+                pack_ternary_planes(src, c_eff, sign_tile[j], nonzero_tile[j]);
+            }
+
+            transpose_bits32(sign_tile);
+            transpose_bits32(nonzero_tile);
+
+            for (u32 i = 0; i < c_eff; ++i) {
+                u32* dst = out.data() + (static_cast<usize>(c0 + i) * k_words + kw) * 2u;
+                dst[0] = sign_tile[i];
+                dst[1] = nonzero_tile[i];
+            }
+        }
     }
+    return {};
+}
 
+auto f32_mat_to_packed_ternary_u32_row_major_cpu_native_standalone(
+    std::span<const f32> in,
+    u32 matrix_side,
+    u32 k_bits
+) -> std::expected<std::vector<u32>, device_error> {
+    std::vector<u32> out(static_cast<usize>(matrix_side) * ((k_bits + 31u) / 32u) * 2u);
 
+    auto res = f32_mat_to_packed_ternary_u32_row_major_cpu_native_standalone(in, out, matrix_side, k_bits);
+    if (!res.has_value()) return std::unexpected{ res.error() };
     return out;
 }
 
-auto random_mat_binary_f32_1d_full_range_dist_cpu_native_standalone(
-    u32 rows, u32 cols, u32 seed
-) -> std::expected<std::vector<f32>, device_error> {
-    if (rows == 0 || cols == 0){
-        return std::unexpected{ device_error::launch_failed };
+auto f32_mat_to_packed_ternary_u32_col_major_cpu_native_standalone(
+    std::span<const f32> in,
+    u32 matrix_side,
+    u32 k_bits
+) -> std::expected<std::vector<u32>, device_error> {
+    std::vector<u32> out(static_cast<usize>(matrix_side) * ((k_bits + 31u) / 32u) * 2u);
+
+    auto res = f32_mat_to_packed_ternary_u32_col_major_cpu_native_standalone(in, out, matrix_side, k_bits);
+    if (!res.has_value()) return std::unexpected{ res.error() };
+    return out;
+}
+
+// Random matrices come from a counter-based generator: element i is a pure function of (seed, i), namely
+// SplitMix64 evaluated at position i of the stream keyed by the seed. There is no carried state, so any
+// range of a matrix can be generated on its own. The pool overloads split the matrix into fixed chunks
+// and produce bit-identical output whatever the thread count, and the SIMD kernels produce the same
+// bits as the scalar one.
+//
+// Every domain maps the high 32 bits of one draw to a value:
+//   pm_one      -> bit 31 picks -1.0f or +1.0f
+//   zero_one    -> top 24 bits scaled to [0, 1)
+//   full_range  -> (zero_one - 0.5f) * 2e6f, [-1e6, 1e6)
+//   trinary     -> floor(h * 3 / 2^32) in { 0, 1, 2 } mapped to { -1.0f, 0.0f, +1.0f }
+
+namespace {
+
+static inline auto counter_rng_u64(tether_io::u64 key, tether_io::u64 counter) -> tether_io::u64 {
+    tether_io::u64 z = key + (counter + 1u) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Seeds are run through the mixer once so neighbouring seeds do not give overlapping streams
+static inline auto counter_rng_key(tether_io::u32 seed) -> tether_io::u64 {
+    return counter_rng_u64(0x6A09E667F3BCC909ull, seed);
+}
+
+// floor(h * 3 / 2^32) crosses to 1 and 2 at these values of h
+constexpr tether_io::u32 trinary_threshold_zero = 0x55555556u;
+constexpr tether_io::u32 trinary_threshold_one  = 0xAAAAAAABu;
+
+struct random_pm_one_dist {
+    static auto scalar(tether_io::u32 h) -> tether_io::f32 {
+        return static_cast<tether_io::f32>(static_cast<tether_io::i32>(h >> 31) * 2 - 1);
+    }
+#ifdef TETHER_IO_ARCH_X86_64
+    TETHER_IO_TARGET_AVX2 static auto avx2(__m256i h) -> __m256 {
+        const __m256i bit = _mm256_srli_epi32(h, 31);
+        return _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_add_epi32(bit, bit), _mm256_set1_epi32(1)));
+    }
+#endif
+};
+
+struct random_zero_one_dist {
+    static auto scalar(tether_io::u32 h) -> tether_io::f32 {
+        return static_cast<tether_io::f32>(static_cast<tether_io::i32>(h >> 8)) * 0x1.0p-24f;
+    }
+#ifdef TETHER_IO_ARCH_X86_64
+    TETHER_IO_TARGET_AVX2 static auto avx2(__m256i h) -> __m256 {
+        return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(h, 8)), _mm256_set1_ps(0x1.0p-24f));
+    }
+#endif
+};
+
+// The subtraction is exact, leaving a single rounding in the multiply (nothing to contract into an FMA)
+struct random_full_range_dist {
+    static auto scalar(tether_io::u32 h) -> tether_io::f32 {
+        return (random_zero_one_dist::scalar(h) - 0.5f) * 2e6f;
     }
+#ifdef TETHER_IO_ARCH_X86_64
+    TETHER_IO_TARGET_AVX2 static auto avx2(__m256i h) -> __m256 {
+        return _mm256_mul_ps(_mm256_sub_ps(random_zero_one_dist::avx2(h), _mm256_set1_ps(0.5f)), _mm256_set1_ps(2e6f));
+    }
+#endif
+};
+
+struct random_trinary_dist {
+    static auto scalar(tether_io::u32 h) -> tether_io::f32 {
+        const tether_io::i32 t = (h >= trinary_threshold_zero ? 1 : 0) + (h >= trinary_threshold_one ? 1 : 0);
+        return static_cast<tether_io::f32>(t - 1);
+    }
+#ifdef TETHER_IO_ARCH_X86_64
+    // AVX2 only compares signed lanes, flipping the sign bit turns it into an unsigned compare
+    TETHER_IO_TARGET_AVX2 static auto avx2(__m256i h) -> __m256 {
+        const __m256i flip = _mm256_set1_epi32(static_cast<tether_io::i32>(0x80000000u));
+        const __m256i hs   = _mm256_xor_si256(h, flip);
+        const __m256i ge0  = _mm256_cmpgt_epi32(hs, _mm256_set1_epi32(static_cast<tether_io::i32>((trinary_threshold_zero - 1u) ^ 0x80000000u)));
+        const __m256i ge1  = _mm256_cmpgt_epi32(hs, _mm256_set1_epi32(static_cast<tether_io::i32>((trinary_threshold_one - 1u) ^ 0x80000000u)));
+        // Compare masks are -1, so -1 - mask0 - mask1 counts the thresholds passed
+        return _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_sub_epi32(_mm256_set1_epi32(-1), ge0), ge1));
+    }
+#endif
+};
 
-    std::vector<f32> out;
+using fill_random_f32_fn = void(*)(tether_io::f32*, tether_io::u64 first, tether_io::usize count, tether_io::u64 key);
 
-    f32 lower_bound = -1e6f;
-    f32 upper_bound = 1e6f;
+template<typename Dist>
+static inline auto fill_random_f32_scalar(
+    tether_io::f32* out, tether_io::u64 first, tether_io::usize count, tether_io::u64 key
+) -> void {
+    for (tether_io::usize i = 0; i < count; ++i) {
+        out[i] = Dist::scalar(static_cast<tether_io::u32>(counter_rng_u64(key, first + i) >> 32));
+    }
+}
 
-    // Create random number generator
-    std::random_device rd;  // Seed source (hardware)
-    std::mt19937 gen(rd()); // Mersenne Twister engine
-    std::uniform_real_distribution<f32> dist(lower_bound, upper_bound);
+#ifdef TETHER_IO_ARCH_X86_64
 
-    out.resize(static_cast<usize>(rows) * cols);
+// Low 64 bits of a * b out of 32 x 32 -> 64 partial products, b_high holds the high halves of b in the low ones
+TETHER_IO_TARGET_AVX2 static inline auto mullo_epi64_avx2(__m256i a, __m256i b, __m256i b_high) -> __m256i {
+    const __m256i lo    = _mm256_mul_epu32(a, b);
+    const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b), _mm256_mul_epu32(a, b_high));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
 
-    for (usize i = 0; i < out.size(); ++i){
-        out[i] =  dist(gen);
+// SplitMix64 output function on four states
+TETHER_IO_TARGET_AVX2 static inline auto splitmix64_mix_avx2(__m256i z) -> __m256i {
+    const __m256i mul0 = _mm256_set1_epi64x(static_cast<tether_io::i64>(0xBF58476D1CE4E5B9ull));
+    const __m256i mul1 = _mm256_set1_epi64x(static_cast<tether_io::i64>(0x94D049BB133111EBull));
+    z = mullo_epi64_avx2(_mm256_xor_si256(z, _mm256_srli_epi64(z, 30)), mul0, _mm256_srli_epi64(mul0, 32));
+    z = mullo_epi64_avx2(_mm256_xor_si256(z, _mm256_srli_epi64(z, 27)), mul1, _mm256_srli_epi64(mul1, 32));
+    return _mm256_xor_si256(z, _mm256_srli_epi64(z, 31));
+}
+
+// Eight draws per step. The states key + (i + 1) * gamma advance by an add, leaving two multiplies per draw,
+// the two vectors of four 64-bit results are narrowed to their eight high halves in order.
+template<typename Dist>
+TETHER_IO_TARGET_AVX2 static inline auto fill_random_f32_avx2(
+    tether_io::f32* out, tether_io::u64 first, tether_io::usize count, tether_io::u64 key
+) -> void {
+    constexpr tether_io::u64 gamma = 0x9E3779B97F4A7C15ull;
+    const __m256i gather = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m256i step   = _mm256_set1_epi64x(static_cast<tether_io::i64>(8u * gamma));
+
+    const tether_io::u64 s = key + (first + 1u) * gamma;
+    __m256i state0 = _mm256_setr_epi64x(
+        static_cast<tether_io::i64>(s),             static_cast<tether_io::i64>(s + gamma),
+        static_cast<tether_io::i64>(s + 2u * gamma), static_cast<tether_io::i64>(s + 3u * gamma));
+    __m256i state1 = _mm256_add_epi64(state0, _mm256_set1_epi64x(static_cast<tether_io::i64>(4u * gamma)));
+
+    tether_io::usize i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i r0 = splitmix64_mix_avx2(state0);
+        const __m256i r1 = splitmix64_mix_avx2(state1);
+        state0 = _mm256_add_epi64(state0, step);
+        state1 = _mm256_add_epi64(state1, step);
+
+        // [r0.0h r1.0h r0.1h r1.1h ...] -> [r0.0h r0.1h r0.2h r0.3h r1.0h ...]
+        const __m256i mixed = _mm256_blend_epi32(_mm256_srli_epi64(r0, 32), r1, 0b10101010);
+        const __m256i high  = _mm256_permutevar8x32_epi32(mixed, gather);
+        _mm256_storeu_ps(out + i, Dist::avx2(high));
     }
+    fill_random_f32_scalar<Dist>(out + i, first + i, count - i, key);
+}
 
+// Same stream eight 64-bit states at a time, AVX-512F narrows them to their high halves in one instruction
+template<typename Dist>
+TETHER_IO_TARGET_AVX512_VPOPCNTDQ static inline auto fill_random_f32_avx512(
+    tether_io::f32* out, tether_io::u64 first, tether_io::usize count, tether_io::u64 key
+) -> void {
+    constexpr tether_io::u64 gamma = 0x9E3779B97F4A7C15ull;
+    const __m512i step = _mm512_set1_epi64(static_cast<tether_io::i64>(8u * gamma));
+    const __m512i mul0 = _mm512_set1_epi64(static_cast<tether_io::i64>(0xBF58476D1CE4E5B9ull));
+    const __m512i mul1 = _mm512_set1_epi64(static_cast<tether_io::i64>(0x94D049BB133111EBull));
+
+    const tether_io::u64 s = key + (first + 1u) * gamma;
+    __m512i state = _mm512_add_epi64(
+        _mm512_set1_epi64(static_cast<tether_io::i64>(s)),
+        _mm512_mullox_epi64(_mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7), _mm512_set1_epi64(static_cast<tether_io::i64>(gamma))));
+
+    tether_io::usize i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512i z = state;
+        z = _mm512_mullox_epi64(_mm512_xor_si512(z, _mm512_srli_epi64(z, 30)), mul0);
+        z = _mm512_mullox_epi64(_mm512_xor_si512(z, _mm512_srli_epi64(z, 27)), mul1);
+        z = _mm512_xor_si512(z, _mm512_srli_epi64(z, 31));
+        state = _mm512_add_epi64(state, step);
+
+        _mm256_storeu_ps(out + i, Dist::avx2(_mm512_cvtepi64_epi32(_mm512_srli_epi64(z, 32))));
+    }
+    fill_random_f32_scalar<Dist>(out + i, first + i, count - i, key);
+}
 
+#endif
+
+template<typename Dist>
+static inline auto select_fill_random_f32(tether_io::cpu_isa isa) -> fill_random_f32_fn {
+    switch (isa) {
+#ifdef TETHER_IO_ARCH_X86_64
+        case tether_io::cpu_isa::avx2:             return fill_random_f32_avx2<Dist>;
+        case tether_io::cpu_isa::avx512_vpopcntdq: return fill_random_f32_avx512<Dist>;
+#endif
+        default:                                   return fill_random_f32_scalar<Dist>;
+    }
+}
+
+// Elements per parallel task. Every element only depends on its index, the split never shows in the output
+constexpr tether_io::usize random_fill_chunk = 1u << 16;
+
+template<typename Dist>
+static inline auto random_mat_f32(
+    tether_io::cpu_thread_pool* pool, std::span<tether_io::f32> out,
+    tether_io::u32 rows, tether_io::u32 cols, tether_io::u32 seed, tether_io::cpu_isa isa
+) -> std::expected<void, tether_io::device_error> {
+    if (rows == 0 || cols == 0 || out.size() != static_cast<tether_io::usize>(rows) * cols){
+        return std::unexpected{ tether_io::device_error::launch_failed };
+    }
+    if (!tether_io::is_cpu_isa_supported(isa)){
+        return std::unexpected{ tether_io::device_error::not_available };
+    }
+
+    const fill_random_f32_fn fill = select_fill_random_f32<Dist>(isa);
+    const tether_io::u64 key = counter_rng_key(seed);
+
+    const tether_io::usize chunks = (out.size() + random_fill_chunk - 1) / random_fill_chunk;
+    auto run_chunk = [&](tether_io::usize chunk, tether_io::usize) {
+        const tether_io::usize begin = chunk * random_fill_chunk;
+        fill(out.data() + begin, begin, std::min(random_fill_chunk, out.size() - begin), key);
+    };
+
+    if (pool && chunks > 1) {
+        pool->parallel_for(chunks, run_chunk);
+    } else {
+        fill(out.data(), 0, out.size(), key);
+    }
+    return {};
+}
+
+}
+
+// Create a random matrix with binary distribution as floating point representation (-1.f, 1.0f)
+auto random_mat_binary_f32_1d_pm_one_dist_cpu_native_standalone(
+    std::span<f32> out, u32 rows, u32 cols, u32 seed, cpu_isa isa = best_cpu_isa()
+) -> std::expected<void, device_error> {
+    return random_mat_f32<random_pm_one_dist>(nullptr, out, rows, cols, seed, isa);
+}
+
+auto random_mat_binary_f32_1d_pm_one_dist_cpu_native_standalone(
+    cpu_thread_pool& pool, std::span<f32> out, u32 rows, u32 cols, u32 seed, cpu_isa isa = best_cpu_isa()
+) -> std::expected<void, device_error> {
+    return random_mat_f32<random_pm_one_dist>(&pool, out, rows, cols, seed, isa);
+}
+
+auto random_mat_binary_f32_1d_pm_one_dist_cpu_native_standalone(
+    u32 rows, u32 cols, u32 seed
+) -> std::expected<std::vector<f32>, device_error> {
+    std::vector<f32> out(static_cast<usize>(rows) * cols);
+
+    auto res = random_mat_binary_f32_1d_pm_one_dist_cpu_native_standalone(out, rows, cols, seed);
+    if (!res.has_value()) return std::unexpected{ res.error() };
     return out;
 }
 
+// Uniform in [0, 1) with 24 bits of resolution
+auto random_mat_binary_f32_1d_zero_one_dist_cpu_native_standalone(
+    std::span<f32> out, u32 rows, u32 cols, u32 seed, cpu_isa isa = best_cpu_isa()
+) -> std::expected<void, device_error> {
+    return random_mat_f32<random_zero_one_dist>(nullptr, out, rows, cols, seed, isa);
+}
+
+auto random_mat_binary_f32_1d_zero_one_dist_cpu_native_standalone(
+    cpu_thread_pool& pool, std::span<f32> out, u32 rows, u32 cols, u32 seed, cpu_isa isa = best_cpu_isa()
+) -> std::expected<void, device_error> {
+    return random_mat_f32<random_zero_one_dist>(&pool, out, rows, cols, seed, isa);
+}
+
+auto random_mat_binary_f32_1d_zero_one_dist_cpu_native_standalone(
+    u32 rows, u32 cols, u32 seed
+) -> std::expected<std::vector<f32>, device_error> {
+    std::vector<f32> out(static_cast<usize>(rows) * cols);
+
+    auto res = random_mat_binary_f32_1d_zero_one_dist_cpu_native_standalone(out, rows, cols, seed);
+    if (!res.has_value()) return std::unexpected{ res.error() };
+    return out;
+}
+
+// Uniform in [-1e6, 1e6)
+auto random_mat_binary_f32_1d_full_range_dist_cpu_native_standalone(
+    std::span<f32> out, u32 rows, u32 cols, u32 seed, cpu_isa isa = best_cpu_isa()
+) -> std::expected<void, device_error> {
+    return random_mat_f32<random_full_range_dist>(nullptr, out, rows, cols, seed, isa);
+}
+
+auto random_mat_binary_f32_1d_full_range_dist_cpu_native_standalone(
+    cpu_thread_pool& pool, std::span<f32> out, u32 rows, u32 cols, u32 seed, cpu_isa isa = best_cpu_isa()
+) -> std::expected<void, device_error> {
+    return random_mat_f32<random_full_range_dist>(&pool, out, rows, cols, seed, isa);
+}
+
+auto random_mat_binary_f32_1d_full_range_dist_cpu_native_standalone(
+    u32 rows, u32 cols, u32 seed
+) -> std::expected<std::vector<f32>, device_error> {
+    std::vector<f32> out(static_cast<usize>(rows) * cols);
+
+    auto res = random_mat_binary_f32_1d_full_range_dist_cpu_native_standalone(out, rows, cols, seed);
+    if (!res.has_value()) return std::unexpected{ res.error() };
+    return out;
+}
+
+// Uniform over { -1.0f, 0.0f, +1.0f }
+auto random_mat_binary_f32_1d_trinary_dist_cpu_native_standalone(
+    std::span<f32> out, u32 rows, u32 cols, u32 seed, cpu_isa isa = best_cpu_isa()
+) -> std::expected<void, device_error> {
+    return random_mat_f32<random_trinary_dist>(nullptr, out, rows, cols, seed, isa);
+}
+
+auto random_mat_binary_f32_1d_trinary_dist_cpu_native_standalone(
+    cpu_thread_pool& pool, std::span<f32> out, u32 rows, u32 cols, u32 seed, cpu_isa isa = best_cpu_isa()
+) -> std::expected<void, device_error> {
+    return random_mat_f32<random_trinary_dist>(&pool, out, rows, cols, seed, isa);
+}
+
 auto random_mat_binary_f32_1d_trinary_dist_cpu_native_standalone(
     u32 rows, u32 cols, u32 seed
 ) -> std::expected<std::vector<f32>, device_error> {
-    if (rows == 0 || cols == 0){
-        return std::unexpected{ device_error::launch_failed };
+    std::vector<f32> out(static_cast<usize>(rows) * cols);
+
+    auto res = random_mat_binary_f32_1d_trinary_dist_cpu_native_standalone(out, rows, cols, seed);
+    if (!res.has_value()) return std::unexpected{ res.error() };
+    return out;
+}
+
+// Packed random matrices, generated straight into the bit layouts of the packers above without the
+// f32 matrix in between. Values come 32 at a time from the same counter stream into a stack buffer and
+// are packed right away, so the result is bit-identical to generating the f32 matrix with the same
+// seed and packing it:
+//   row_major -> the [matrix_side x k_bits] matrix of random_mat_binary_f32_1d(matrix_side, k_bits, seed)
+//   col_major -> the [k_bits x matrix_side] matrix of random_mat_binary_f32_1d(k_bits, matrix_side, seed)
+
+namespace {
+
+static inline auto select_fill_random_f32(tether_io::data_domain domain, tether_io::cpu_isa isa) -> fill_random_f32_fn {
+    switch (domain) {
+        case tether_io::data_domain::pm_one:     return select_fill_random_f32<random_pm_one_dist>(isa);
+        case tether_io::data_domain::zero_one:   return select_fill_random_f32<random_zero_one_dist>(isa);
+        case tether_io::data_domain::full_range: return select_fill_random_f32<random_full_range_dist>(isa);
+        case tether_io::data_domain::trinary:    return select_fill_random_f32<random_trinary_dist>(isa);
+        default:                                 return nullptr;
     }
+}
 
-    std::vector<f32> out;
+enum class random_packing { binary, ternary };
+
+struct random_packed_job {
+    fill_random_f32_fn fill;
+    pack_signs32_fn pack32;
+    tether_io::u64 key;
+    tether_io::u32 matrix_side;
+    tether_io::u32 k_bits;
+    tether_io::u32 k_words;
+};
+
+// Rows [row_begin, row_end) of the row-major layout, one or two words per 32 generated values
+static auto random_packed_row_major_rows(
+    const random_packed_job& job, random_packing packing, tether_io::u32* out,
+    tether_io::u32 row_begin, tether_io::u32 row_end
+) -> void {
+    const tether_io::u32 words_per_step = (packing == random_packing::ternary) ? 2u : 1u;
+
+    tether_io::f32 values[32];
+    for (tether_io::u32 r = row_begin; r < row_end; ++r) {
+        tether_io::u32* dst = out + static_cast<tether_io::usize>(r) * job.k_words * words_per_step;
+
+        for (tether_io::u32 kw = 0; kw < job.k_words; ++kw) {
+            const tether_io::u32 k0 = 32u * kw;
+            const tether_io::u32 count = std::min(32u, job.k_bits - k0);
+            job.fill(values, static_cast<tether_io::u64>(r) * job.k_bits + k0, count, job.key);
+
+            if (packing == random_packing::ternary) {
+                pack_ternary_planes(values, count, dst[2u * kw], dst[2u * kw + 1u]);
+            } else {
+                dst[kw] = (count == 32u) ? job.pack32(values) : pack_signs_scalar(values, count);
+            }
+        }
+    }
+}
 
-    // Create random number generator
-    std::random_device rd;  // Seed source (hardware)
-    std::mt19937 gen(rd()); // Mersenne Twister engine
-    std::uniform_int_distribution<i32> dist(0, 2); // 0, 1, 2
+// Column tiles [tile_begin, tile_end) of the column-major layout. Same 32 (k) x 32 (column) tiles as the
+// column-major packers: every K row of a tile is generated and packed along the columns, the bit
+// transpose then turns the row masks into one K word per column.
+static auto random_packed_col_major_tiles(
+    const random_packed_job& job, random_packing packing, tether_io::u32* out,
+    tether_io::u32 tile_begin, tether_io::u32 tile_end
+) -> void {
+    tether_io::f32 values[32];
+    tether_io::u32 sign_tile[32];
+    tether_io::u32 nonzero_tile[32];
+
+    for (tether_io::u32 t = tile_begin; t < tile_end; ++t) {
+        const tether_io::u32 c0 = 32u * t;
+        const tether_io::u32 c_eff = std::min(32u, job.matrix_side - c0);
+
+        for (tether_io::u32 kw = 0; kw < job.k_words; ++kw) {
+            const tether_io::u32 k0 = 32u * kw;
+            const tether_io::u32 k_eff = std::min(32u, job.k_bits - k0);
+
+            for (tether_io::u32 j = 0; j < 32u; ++j) {
+                if (j >= k_eff) { sign_tile[j] = 0u; nonzero_tile[j] = 0u; continue; }
+
+                job.fill(values, static_cast<tether_io::u64>(k0 + j) * job.matrix_side + c0, c_eff, job.key);
+                if (packing == random_packing::ternary) {
+                    pack_ternary_planes(values, c_eff, sign_tile[j], nonzero_tile[j]);
+                } else {
+                    sign_tile[j] = (c_eff == 32u) ? job.pack32(values) : pack_signs_scalar(values, c_eff);
+                }
+            }
+
+            transpose_bits32(sign_tile);
+            if (packing == random_packing::ternary) {
+                transpose_bits32(nonzero_tile);
+                for (tether_io::u32 i = 0; i < c_eff; ++i) {
+                    tether_io::u32* dst = out + (static_cast<tether_io::usize>(c0 + i) * job.k_words + kw) * 2u;
+                    dst[0] = sign_tile[i];
+                    dst[1] = nonzero_tile[i];
+                }
+            } else {
+                for (tether_io::u32 i = 0; i < c_eff; ++i) {
+                    out[static_cast<tether_io::usize>(c0 + i) * job.k_words + kw] = sign_tile[i];
+                }
+            }
+        }
+    }
+}
 
-    out.resize(static_cast<usize>(rows) * cols);
+static inline auto random_mat_packed(
+    tether_io::cpu_thread_pool* pool, tether_io::data_domain domain, tether_io::matrix_order order,
+    random_packing packing, std::span<tether_io::u32> out,
+    tether_io::u32 matrix_side, tether_io::u32 k_bits, tether_io::u32 seed
+) -> std::expected<void, tether_io::device_error> {
+    const tether_io::u32 k_words = (k_bits + 31u) / 32u;
+    const tether_io::usize words_per_step = (packing == random_packing::ternary) ? 2u : 1u;
 
-    for (usize i = 0; i < out.size(); ++i){
-        f32 x;
-        int r = dist(gen);
-        if (r == 0) x = -1.0f;
-        else if (r == 1) x = 0.0f;
-        else x = 1.0f;
-        
-        out[i] = x;
+    if (matrix_side == 0 || k_bits == 0 || out.size() != static_cast<tether_io::usize>(matrix_side) * k_words * words_per_step){
+        return std::unexpected{ tether_io::device_error::launch_failed };
     }
 
+    const tether_io::cpu_isa isa = tether_io::best_cpu_isa();
+    const fill_random_f32_fn fill = select_fill_random_f32(domain, isa);
+    if (!fill) return std::unexpected{ tether_io::device_error::not_available };
+
+    const random_packed_job job{ fill, select_pack_signs32(isa), counter_rng_key(seed), matrix_side, k_bits, k_words };
+
+    // Rows (row_major) or 32-column tiles (col_major) are the units of work, grouped to about one chunk of values each
+    const tether_io::u32 units = (order == tether_io::matrix_order::row_major) ? matrix_side : (matrix_side + 31u) / 32u;
+    const tether_io::usize values_per_unit = (order == tether_io::matrix_order::row_major) ? k_bits : 32u * static_cast<tether_io::usize>(k_bits);
+    const tether_io::u32 units_per_task = static_cast<tether_io::u32>(std::max<tether_io::usize>(1u, random_fill_chunk / values_per_unit));
+    const tether_io::usize tasks = (units + units_per_task - 1u) / units_per_task;
+
+    auto run_task = [&](tether_io::usize task, tether_io::usize) {
+        const tether_io::u32 begin = static_cast<tether_io::u32>(task) * units_per_task;
+        const tether_io::u32 end = std::min(units, begin + units_per_task);
+        if (order == tether_io::matrix_order::row_major) {
+            random_packed_row_major_rows(job, packing, out.data(), begin, end);
+        } else {
+            random_packed_col_major_tiles(job, packing, out.data(), begin, end);
+        }
+    };
+
+    if (pool && tasks > 1) {
+        pool->parallel_for(tasks, run_task);
+    } else {
+        for (tether_io::usize task = 0; task < tasks; ++task) run_task(task, 0);
+    }
+    return {};
+}
+
+}
 
+// Binary packing of a random matrix, output [matrix_side x k_words]
+auto random_mat_packed_u32_cpu_native_standalone(
+    data_domain domain, matrix_order order, std::span<u32> out, u32 matrix_side, u32 k_bits, u32 seed
+) -> std::expected<void, device_error> {
+    return random_mat_packed(nullptr, domain, order, random_packing::binary, out, matrix_side, k_bits, seed);
+}
+
+auto random_mat_packed_u32_cpu_native_standalone(
+    cpu_thread_pool& pool, data_domain domain, matrix_order order, std::span<u32> out, u32 matrix_side, u32 k_bits, u32 seed
+) -> std::expected<void, device_error> {
+    return random_mat_packed(&pool, domain, order, random_packing::binary, out, matrix_side, k_bits, seed);
+}
+
+auto random_mat_packed_u32_cpu_native_standalone(
+    data_domain domain, matrix_order order, u32 matrix_side, u32 k_bits, u32 seed
+) -> std::expected<std::vector<u32>, device_error> {
+    std::vector<u32> out(static_cast<usize>(matrix_side) * ((k_bits + 31u) / 32u));
+
+    auto res = random_mat_packed_u32_cpu_native_standalone(domain, order, out, matrix_side, k_bits, seed);
+    if (!res.has_value()) return std::unexpected{ res.error() };
     return out;
 }
 
+// Ternary (sign, nonzero) packing of a random matrix, output [matrix_side x k_words x 2]
+auto random_mat_packed_ternary_u32_cpu_native_standalone(
+    data_domain domain, matrix_order order, std::span<u32> out, u32 matrix_side, u32 k_bits, u32 seed
+) -> std::expected<void, device_error> {
+    return random_mat_packed(nullptr, domain, order, random_packing::ternary, out, matrix_side, k_bits, seed);
+}
+
+auto random_mat_packed_ternary_u32_cpu_native_standalone(
+    cpu_thread_pool& pool, data_domain domain, matrix_order order, std::span<u32> out, u32 matrix_side, u32 k_bits, u32 seed
+) -> std::expected<void, device_error> {
+    return random_mat_packed(&pool, domain, order, random_packing::ternary, out, matrix_side, k_bits, seed);
+}
+
+auto random_mat_packed_ternary_u32_cpu_native_standalone(
+    data_domain domain, matrix_order order, u32 matrix_side, u32 k_bits, u32 seed
+) -> std::expected<std::vector<u32>, device_error> {
+    std::vector<u32> out(static_cast<usize>(matrix_side) * ((k_bits + 31u) / 32u) * 2u);
+
+    auto res = random_mat_packed_ternary_u32_cpu_native_standalone(domain, order, out, matrix_side, k_bits, seed);
+    if (!res.has_value()) return std::unexpected{ res.error() };
+    return out;
+}
 
 
 } // tether_io
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <span>
+#include <expected>
+#include <vector>
+#include <bit>
+#include <algorithm>
+
+#include "../../types.hpp"
+#include "cpu_features.hpp"
+#include "binmatmul.hpp"
+
+namespace tether_io{
+
+// Ternary (1.58-bit) GEMM on the two-plane format of f32_mat_to_packed_ternary_u32_*:
+// A is [m x k_words x 2], B is [n x k_words x 2] (each original column becomes a row), pairs are (sign, nonzero).
+// Per word, only positions where both operands are nonzero contribute, agreeing signs add +1 and differing
+// signs add -1:
+//   dot += popcount((a_nz & b_nz) & ~(a_s ^ b_s)) - popcount((a_nz & b_nz) & (a_s ^ b_s))
+// Tail bits are zero in the nonzero plane, so no extra masking is needed.
+auto ternmatmul_cpu_native_standalone(
+    std::span<const u32> a_planes,
+    std::span<const u32> b_planes,
+    std::span<i32> c,
+    u32 m, u32 n, u32 k_bits
+) -> std::expected<void, device_error> {
+    const u32 k_words = (k_bits + 31u) / 32u;
+
+    const usize a_needed = static_cast<usize>(m) * k_words * 2u;
+    const usize b_needed = static_cast<usize>(n) * k_words * 2u;
+
+    if (a_planes.size() != a_needed || b_planes.size() != b_needed || c.size() != static_cast<usize>(m) * n) {
+        return std::unexpected(device_error::launch_failed);
+    }
+
+    for (u32 r = 0; r < m; ++r) {
+        const usize a_row = static_cast<usize>(r) * k_words * 2u;
+
+        for (u32 col = 0; col < n; ++col) {
+            const usize b_row = static_cast<usize>(col) * k_words * 2u;
+
+            i32 acc = 0;
+            for (u32 kw = 0; kw < k_words; ++kw) {
+                const u32 nz   = a_planes[a_row + 2u * kw + 1u] & b_planes[b_row + 2u * kw + 1u];
+                const u32 diff = a_planes[a_row + 2u * kw] ^ b_planes[b_row + 2u * kw];
+                acc += std::popcount(nz & ~diff) - std::popcount(nz & diff);
+            }
+
+            c[static_cast<usize>(r) * n + col] = acc;
+        }
+    }
+
+    return {};
+}
+
+auto ternmatmul_cpu_native_standalone(
+    std::span<const u32> a_planes,
+    std::span<const u32> b_planes,
+    u32 m, u32 n, u32 k_bits
+) -> std::expected<std::vector<i32>, device_error> {
+    std::vector<i32> c(static_cast<usize>(m) * n);
+
+    auto res = ternmatmul_cpu_native_standalone(a_planes, b_planes, c, m, n, k_bits);
+    if (!res.has_value()) return std::unexpected(res.error());
+    return c;
+}
+
+// Float reference: plain GEMM of the ternary-quantized inputs, A row-major [m x k], B row-major [k x n].
+// Every partial sum is an integer of magnitude <= k, so f32 accumulation stays exact while k < 2^24.
+auto ternmatmul_f32_reference_cpu_native_standalone(
+    std::span<const f32> a,
+    std::span<const f32> b,
+    u32 m, u32 n, u32 k
+) -> std::expected<std::vector<i32>, device_error> {
+    if (a.size() != static_cast<usize>(m) * k || b.size() != static_cast<usize>(k) * n) {
+        return std::unexpected(device_error::launch_failed);
+    }
+
+    auto ternarize = [](f32 v) -> f32 { return v > 0.0f ? 1.0f : (v < 0.0f ? -1.0f : 0.0f); };
+
+    std::vector<f32> acc(n);
+    std::vector<i32> c(static_cast<usize>(m) * n);
+
+    for (u32 r = 0; r < m; ++r) {
+        std::fill(acc.begin(), acc.end(), 0.0f);
+
+        for (u32 kk = 0; kk < k; ++kk) {
+            const f32 av = ternarize(a[static_cast<usize>(r) * k + kk]);
+            if (av == 0.0f) continue;
+
+            const f32* b_row = b.data() + static_cast<usize>(kk) * n;
+            for (u32 col = 0; col < n; ++col) acc[col] += av * ternarize(b_row[col]);
+        }
+
+        for (u32 col = 0; col < n; ++col) c[static_cast<usize>(r) * n + col] = static_cast<i32>(acc[col]);
+    }
+
+    return c;
+}
+
+} // tether_io
+
+namespace {
+
+// The vectorized kernels read one (sign, nonzero) pair as a 64-bit lane: sign in the low half, nonzero in
+// the high half. Shifting (a & b) down by 32 leaves the common nonzero mask in the low half, so per lane
+//   both  = (a & b) >> 32             positions where both weights are nonzero
+//   neg   = both & (a ^ b)            the subset with differing signs
+//   dot  += popcount(both) - 2 * popcount(neg)
+
+static inline auto ternary_pair_dot(const tether_io::u32* a, const tether_io::u32* b) -> tether_io::i32 {
+    const tether_io::u32 both = a[1] & b[1];
+    const tether_io::u32 neg  = both & (a[0] ^ b[0]);
+    return std::popcount(both) - 2 * std::popcount(neg);
+}
+
+#ifdef TETHER_IO_ARCH_X86_64
+
+TETHER_IO_TARGET_AVX2 static auto ternmatmul_dot_avx2(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::u32 k_words
+) -> tether_io::i32 {
+    constexpr tether_io::u32 pairs = 4u; // (sign, nonzero) pairs per ymm
+    __m256i both_count = _mm256_setzero_si256();
+    __m256i neg_count  = _mm256_setzero_si256();
+
+    tether_io::u32 kw = 0;
+    for (; kw + pairs <= k_words; kw += pairs) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + 2u * kw));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 2u * kw));
+        const __m256i both = _mm256_srli_epi64(_mm256_and_si256(va, vb), 32);
+        const __m256i neg  = _mm256_and_si256(both, _mm256_xor_si256(va, vb));
+        both_count = _mm256_add_epi64(both_count, popcount_epi64_avx2(both));
+        neg_count  = _mm256_add_epi64(neg_count, popcount_epi64_avx2(neg));
+    }
+
+    const __m256i dot = _mm256_sub_epi64(both_count, _mm256_slli_epi64(neg_count, 1));
+    tether_io::i64 acc =
+        _mm256_extract_epi64(dot, 0) + _mm256_extract_epi64(dot, 1) +
+        _mm256_extract_epi64(dot, 2) + _mm256_extract_epi64(dot, 3);
+
+    for (; kw < k_words; ++kw) acc += ternary_pair_dot(a + 2u * kw, b + 2u * kw);
+    return static_cast<tether_io::i32>(acc);
+}
+
+TETHER_IO_TARGET_AVX512_VPOPCNTDQ static auto ternmatmul_dot_avx512(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::u32 k_words
+) -> tether_io::i32 {
+    constexpr tether_io::u32 pairs = 8u; // (sign, nonzero) pairs per zmm
+    __m512i both_count = _mm512_setzero_si512();
+    __m512i neg_count  = _mm512_setzero_si512();
+
+    tether_io::u32 kw = 0;
+    for (; kw < k_words; kw += pairs) {
+        // The masked load zero-fills the remainder, zero nonzero planes contribute nothing
+        const tether_io::u32 rest = std::min(pairs, k_words - kw);
+        const __mmask8 lanes = static_cast<__mmask8>((1u << rest) - 1u);
+        const __m512i va = _mm512_maskz_loadu_epi64(lanes, a + 2u * kw);
+        const __m512i vb = _mm512_maskz_loadu_epi64(lanes, b + 2u * kw);
+        const __m512i both = _mm512_srli_epi64(_mm512_and_si512(va, vb), 32);
+        const __m512i neg  = _mm512_and_si512(both, _mm512_xor_si512(va, vb));
+        both_count = _mm512_add_epi64(both_count, _mm512_popcnt_epi64(both));
+        neg_count  = _mm512_add_epi64(neg_count, _mm512_popcnt_epi64(neg));
+    }
+
+    return static_cast<tether_io::i32>(
+        _mm512_reduce_add_epi64(both_count) - 2 * _mm512_reduce_add_epi64(neg_count)
+    );
+}
+
+#endif // TETHER_IO_ARCH_X86_64
+
+#ifdef TETHER_IO_ARCH_ARM64
+
+static auto ternmatmul_dot_neon(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::u32 k_words
+) -> tether_io::i32 {
+    uint32x4_t both_count = vdupq_n_u32(0);
+    uint32x4_t neg_count  = vdupq_n_u32(0);
+
+    tether_io::u32 kw = 0;
+    for (; kw + 2u <= k_words; kw += 2u) {
+        const uint64x2_t va = vreinterpretq_u64_u32(vld1q_u32(a + 2u * kw));
+        const uint64x2_t vb = vreinterpretq_u64_u32(vld1q_u32(b + 2u * kw));
+        const uint64x2_t both = vshrq_n_u64(vandq_u64(va, vb), 32);
+        const uint64x2_t neg  = vandq_u64(both, veorq_u64(va, vb));
+        both_count = vpadalq_u16(both_count, vpaddlq_u8(vcntq_u8(vreinterpretq_u8_u64(both))));
+        neg_count  = vpadalq_u16(neg_count, vpaddlq_u8(vcntq_u8(vreinterpretq_u8_u64(neg))));
+    }
+
+    tether_io::i32 acc = static_cast<tether_io::i32>(vaddvq_u32(both_count)) - 2 * static_cast<tether_io::i32>(vaddvq_u32(neg_count));
+    for (; kw < k_words; ++kw) acc += ternary_pair_dot(a + 2u * kw, b + 2u * kw);
+    return acc;
+}
+
+#endif // TETHER_IO_ARCH_ARM64
+
+static auto ternmatmul_dot_scalar(
+    const tether_io::u32* a, const tether_io::u32* b, tether_io::u32 k_words
+) -> tether_io::i32 {
+    tether_io::i32 acc = 0;
+    for (tether_io::u32 kw = 0; kw < k_words; ++kw) acc += ternary_pair_dot(a + 2u * kw, b + 2u * kw);
+    return acc;
+}
+
+using ternmatmul_dot_fn = tether_io::i32 (*)(const tether_io::u32*, const tether_io::u32*, tether_io::u32);
+
+static inline auto select_ternmatmul_dot(tether_io::cpu_isa isa) -> ternmatmul_dot_fn {
+    switch (isa) {
+#ifdef TETHER_IO_ARCH_X86_64
+        case tether_io::cpu_isa::avx2:             return ternmatmul_dot_avx2;
+        case tether_io::cpu_isa::avx512_vpopcntdq: return ternmatmul_dot_avx512;
+#endif
+#ifdef TETHER_IO_ARCH_ARM64
+        case tether_io::cpu_isa::neon:             return ternmatmul_dot_neon;
+#endif
+        default:                                   return ternmatmul_dot_scalar;
+    }
+}
+
+}
+
+namespace tether_io{
+
+// Runs the requested variant, ternmatmul_cpu_native_standalone stays the source of truth for all of them.
+auto ternmatmul_isa_cpu_native_standalone(
+    std::span<const u32> a_planes,
+    std::span<const u32> b_planes,
+    std::span<i32> c,
+    u32 m, u32 n, u32 k_bits,
+    cpu_isa isa
+) -> std::expected<void, device_error> {
+    if (isa == cpu_isa::scalar) return ternmatmul_cpu_native_standalone(a_planes, b_planes, c, m, n, k_bits);
+
+    const u32 k_words = (k_bits + 31u) / 32u;
+
+    if (a_planes.size() != static_cast<usize>(m) * k_words * 2u ||
+        b_planes.size() != static_cast<usize>(n) * k_words * 2u ||
+        c.size() != static_cast<usize>(m) * n) {
+        return std::unexpected(device_error::launch_failed);
+    }
+
+    if (!is_cpu_isa_supported(isa)) return std::unexpected(device_error::not_available);
+
+    const ternmatmul_dot_fn dot = select_ternmatmul_dot(isa);
+
+    for (u32 r = 0; r < m; ++r) {
+        const u32* a_row = a_planes.data() + static_cast<usize>(r) * k_words * 2u;
+
+        for (u32 col = 0; col < n; ++col) {
+            const u32* b_row = b_planes.data() + static_cast<usize>(col) * k_words * 2u;
+            c[static_cast<usize>(r) * n + col] = dot(a_row, b_row, k_words);
+        }
+    }
+
+    return {};
+}
+
+auto ternmatmul_isa_cpu_native_standalone(
+    std::span<const u32> a_planes,
+    std::span<const u32> b_planes,
+    u32 m, u32 n, u32 k_bits,
+    cpu_isa isa
+) -> std::expected<std::vector<i32>, device_error> {
+    std::vector<i32> c(static_cast<usize>(m) * n);
+
+    auto res = ternmatmul_isa_cpu_native_standalone(a_planes, b_planes, c, m, n, k_bits, isa);
+    if (!res.has_value()) return std::unexpected(res.error());
+    return c;
+}
+
+} // tether_io
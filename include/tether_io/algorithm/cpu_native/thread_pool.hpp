@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "../../types.hpp"
+
+namespace tether_io{
+
+// Persistent pool of worker threads that runs index-based jobs with work stealing.
+//
+// Every job is a range of task indices [0, task_count). The range is split evenly over one queue per
+// worker, a worker pops tasks from the front of its own queue and, once that is empty, steals half of
+// the remaining tasks from the back of another queue. A queue is a single packed (begin, end) pair so
+// pops and steals are one compare-exchange each and a job never allocates.
+//
+// The calling thread takes part as worker 0, a pool of `thread_count` threads therefore spawns
+// `thread_count - 1` threads once and reuses them for every parallel_for.
+class cpu_thread_pool {
+public:
+    explicit cpu_thread_pool(usize thread_count = 0) {
+        if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+        queues = std::make_unique<worker_queue[]>(thread_count);
+        worker_count = thread_count;
+
+        workers.reserve(thread_count - 1);
+        for (usize w = 1; w < thread_count; ++w) {
+            workers.emplace_back([this, w] { worker_loop(w); });
+        }
+    }
+
+    cpu_thread_pool(const cpu_thread_pool&) = delete;
+    cpu_thread_pool& operator=(const cpu_thread_pool&) = delete;
+
+    ~cpu_thread_pool() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+            ++generation;
+        }
+        wake.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    auto thread_count() const -> usize { return worker_count; }
+
+    // Calls fn(task, worker) for every task in [0, task_count) and returns once all of them finished.
+    // `worker` is in [0, thread_count()) and can index per-thread scratch memory.
+    template<typename F>
+    auto parallel_for(usize task_count, F&& fn) -> void {
+        if (task_count == 0) return;
+
+        if (worker_count == 1 || task_count == 1) {
+            for (usize t = 0; t < task_count; ++t) fn(t, 0);
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            job_ctx = static_cast<void*>(&fn);
+            job_invoke = [](void* ctx, usize task, usize worker) {
+                (*static_cast<std::remove_reference_t<F>*>(ctx))(task, worker);
+            };
+
+            // Contiguous slices keep neighbouring tiles (and their B rows) on one worker
+            for (usize w = 0; w < worker_count; ++w) {
+                const u64 begin = task_count * w / worker_count;
+                const u64 end   = task_count * (w + 1) / worker_count;
+                queues[w].range.store(pack(begin, end), std::memory_order_relaxed);
+            }
+
+            remaining.store(task_count, std::memory_order_relaxed);
+            active = 1; // the calling thread
+            ++generation;
+        }
+        wake.notify_all();
+
+        run_tasks(0, job_invoke, job_ctx);
+
+        std::unique_lock lock(mutex);
+        --active;
+        done.wait(lock, [this] { return remaining.load(std::memory_order_acquire) == 0 && active == 0; });
+    }
+
+private:
+    struct alignas(64) worker_queue {
+        std::atomic<u64> range { 0 };
+    };
+
+    using invoke_fn = void (*)(void*, usize, usize);
+
+    usize worker_count { 1 };
+    std::unique_ptr<worker_queue[]> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    u64 generation { 0 };
+    usize active { 0 };
+    bool stopping { false };
+
+    void* job_ctx { nullptr };
+    invoke_fn job_invoke { nullptr };
+    std::atomic<usize> remaining { 0 };
+
+    static auto pack(u64 begin, u64 end) -> u64 { return (begin << 32) | end; }
+    static auto range_begin(u64 range) -> u64 { return range >> 32; }
+    static auto range_end(u64 range) -> u64 { return range & 0xFFFFFFFFull; }
+
+    auto pop_front(usize w, u64& task) -> bool {
+        u64 range = queues[w].range.load(std::memory_order_acquire);
+        while (range_begin(range) < range_end(range)) {
+            if (queues[w].range.compare_exchange_weak(range, pack(range_begin(range) + 1, range_end(range)), std::memory_order_acq_rel)) {
+                task = range_begin(range);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Moves the back half of a victim's queue into the (empty) queue of worker `w`
+    auto steal(usize w) -> bool {
+        for (usize offset = 1; offset < worker_count; ++offset) {
+            const usize victim = (w + offset) % worker_count;
+
+            u64 range = queues[victim].range.load(std::memory_order_acquire);
+            while (range_begin(range) < range_end(range)) {
+                const u64 begin = range_begin(range);
+                const u64 end   = range_end(range);
+                const u64 take  = (end - begin + 1) / 2;
+
+                if (queues[victim].range.compare_exchange_weak(range, pack(begin, end - take), std::memory_order_acq_rel)) {
+                    queues[w].range.store(pack(end - take, end), std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    auto run_tasks(usize w, invoke_fn invoke, void* ctx) -> void {
+        u64 task = 0;
+        for (;;) {
+            while (pop_front(w, task)) {
+                invoke(ctx, static_cast<usize>(task), w);
+
+                if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard lock(mutex);
+                    done.notify_all();
+                }
+            }
+            if (!steal(w)) return;
+        }
+    }
+
+    auto worker_loop(usize w) -> void {
+        u64 seen = 0;
+        for (;;) {
+            invoke_fn invoke = nullptr;
+            void* ctx = nullptr;
+            {
+                std::unique_lock lock(mutex);
+                wake.wait(lock, [&] { return generation != seen; });
+                seen = generation;
+                if (stopping) return;
+
+                // Joining a job that already drained could pick up tasks of the next one with a stale
+                // function, only join while tasks are outstanding so the caller waits for us.
+                if (remaining.load(std::memory_order_acquire) == 0) continue;
+
+                invoke = job_invoke;
+                ctx = job_ctx;
+                ++active;
+            }
+
+            run_tasks(w, invoke, ctx);
+
+            std::lock_guard lock(mutex);
+            --active;
+            done.notify_all();
+        }
+    }
+};
+
+} // tether_io
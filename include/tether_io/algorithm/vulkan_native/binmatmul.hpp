@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <vector>
 #include <expected>
 #include <concepts>
@@ -20,33 +23,146 @@ layout(push_constant) uniform PushConsts {
 } pc;
 */
 
+// launch_method::async lets consecutive calls be in flight together instead of each waiting for the previous
+// launch of the shared kernel, wait_for_last_kernel() then covers all of them (queue submission order).
+// Runs the kernel index.json selects for "binmatmul": binmatmul (one invocation reads a full row and column)
+// or binmatmul_tiled (the workgroup stages K chunks of its rows and columns in shared memory), same grid either way.
+// binmatmul_microtile computes a binmatmul_micro_tile block of C per invocation, its grid shrinks by that factor
+// (binmatmul_launch_geometry with the tile), a grid sized for one element per invocation still gives correct results.
 auto binmatmul_vulkan_native_sequenced(
     compute_context<device_driver::vulkan_native>& ctx,
     application_config& config,
     vec3<u32> grid_size,
     vec3<u32> local_size,
     std::initializer_list<device_buffer<device_driver::vulkan_native>> d_buffers,
-    u32 m, u32 n, u32 k_bits, u32 k_words
+    u32 m, u32 n, u32 k_bits, u32 k_words,
+    launch_method method = launch_method::sync
 ) -> std::expected<void, device_error>{
-    kernel_config kernel_opts = config.kernels["binmatmul"];
+    kernel_config kernel_opts = config.kernels[kernel_variant(config, "binmatmul")];
 
     struct KernelParams { 
         u32 m; u32 n;
         u32 k_bits; u32 k_words; 
     } kernel_params { m, n, k_bits, k_words };
 
+    // Only a multi-element tile has the TILE_M / TILE_N specialization constants
+    const vec2<u32> tile = binmatmul_variant_tile(config);
+    const std::array<u32, 2> micro_tile{ tile.y, tile.x };
+    auto kernel = ctx.register_kernel(
+        kernel_opts, local_size, d_buffers,
+        tile.x * tile.y > 1u ? std::span<const u32>(micro_tile) : std::span<const u32>{}
+    );
+    if (!kernel.has_value()){
+        ctx.exit();
+        return std::unexpected{kernel.error()};
+    }
+
+    // A and B are only read, C is written
+    constexpr std::array access{ buffer_access::read, buffer_access::read, buffer_access::write };
+
+    auto res = ctx.launch_kernel(
+        kernel.value(), 
+        grid_size, 
+        d_buffers, 
+        method, 
+        kernel_params,
+        std::span<const buffer_access>(access)
+    );
+
+    if (!res.has_value()){
+        ctx.destroy_kernel(kernel.value());
+        ctx.exit();
+        return std::unexpected{res.error()};
+    }
+
+    return {};
+}
+
+// Same buffers and push constants as binmatmul, but local_size.x invocations reduce K for one element
+// of C together and local_size.y columns share a workgroup: grid = { ceil(n / local.y), m, 1 }.
+// local_size.x has to be a power of two.
+auto binmatmul_gemv_vulkan_native_sequenced(
+    compute_context<device_driver::vulkan_native>& ctx,
+    application_config& config,
+    vec3<u32> grid_size,
+    vec3<u32> local_size,
+    std::initializer_list<device_buffer<device_driver::vulkan_native>> d_buffers,
+    u32 m, u32 n, u32 k_bits, u32 k_words,
+    launch_method method = launch_method::sync
+) -> std::expected<void, device_error>{
+    kernel_config kernel_opts = config.kernels["binmatmul_gemv"];
+
+    struct KernelParams { 
+        u32 m; u32 n;
+        u32 k_bits; u32 k_words; 
+    } kernel_params { m, n, k_bits, k_words };
+
+    auto kernel = ctx.register_kernel(kernel_opts, local_size, d_buffers);
+    if (!kernel.has_value()){
+        ctx.exit();
+        return std::unexpected{kernel.error()};
+    }
+
+    // A and B are only read, C is written
+    constexpr std::array access{ buffer_access::read, buffer_access::read, buffer_access::write };
+
+    auto res = ctx.launch_kernel(
+        kernel.value(), 
+        grid_size, 
+        d_buffers, 
+        method, 
+        kernel_params,
+        std::span<const buffer_access>(access)
+    );
+
+    if (!res.has_value()){
+        ctx.destroy_kernel(kernel.value());
+        ctx.exit();
+        return std::unexpected{res.error()};
+    }
+
+    return {};
+}
+
+// binmatmul.comp.glsl on buffer_address binding: A, B and C travel as device addresses in the push constants,
+// no descriptor set is bound. Same grid / local size contract as binmatmul_vulkan_native_sequenced.
+auto binmatmul_bda_vulkan_native_sequenced(
+    compute_context<device_driver::vulkan_native>& ctx,
+    application_config& config,
+    vec3<u32> grid_size,
+    vec3<u32> local_size,
+    std::initializer_list<device_buffer<device_driver::vulkan_native>> d_buffers,
+    u32 m, u32 n, u32 k_bits, u32 k_words,
+    launch_method method = launch_method::sync
+) -> std::expected<void, device_error>{
+    kernel_config kernel_opts = config.kernels["binmatmul_bda"];
+
+    if (d_buffers.size() != 3 || std::any_of(d_buffers.begin(), d_buffers.end(), [](const auto& b){ return b.address == 0; })){
+        return std::unexpected{device_error::launch_failed};
+    }
+    const auto* buffs = d_buffers.begin();
+
+    struct KernelParams { 
+        u64 a; u64 b; u64 c;
+        u32 m; u32 n;
+        u32 k_bits; u32 k_words; 
+    } kernel_params { buffs[0].address, buffs[1].address, buffs[2].address, m, n, k_bits, k_words };
+
     auto kernel = ctx.register_kernel(kernel_opts, local_size, d_buffers);
     if (!kernel.has_value()){
         ctx.exit();
         return std::unexpected{kernel.error()};
     }
 
+    constexpr std::array access{ buffer_access::read, buffer_access::read, buffer_access::write };
+
     auto res = ctx.launch_kernel(
         kernel.value(), 
         grid_size, 
         d_buffers, 
-        launch_method::sync, 
-        kernel_params
+        method, 
+        kernel_params,
+        std::span<const buffer_access>(access)
     );
 
     if (!res.has_value()){
@@ -58,6 +174,177 @@ auto binmatmul_vulkan_native_sequenced(
     return {};
 }
 
+// Register-blocked binmatmul: every invocation computes a tile.y x tile.x block of C (specialization constants
+// 3 and 4), reusing each loaded word of A across tile.x columns and each word of B across tile.y rows, with
+// uvec4 loads along K when k_words is a multiple of 4. grid = { ceil(n / (local.x * tile.x)), ceil(m / (local.y * tile.y)), 1 }.
+auto binmatmul_microtile_vulkan_native_sequenced(
+    compute_context<device_driver::vulkan_native>& ctx,
+    application_config& config,
+    vec3<u32> grid_size,
+    vec3<u32> local_size,
+    vec2<u32> tile,
+    std::initializer_list<device_buffer<device_driver::vulkan_native>> d_buffers,
+    u32 m, u32 n, u32 k_bits, u32 k_words,
+    launch_method method = launch_method::sync
+) -> std::expected<void, device_error>{
+    kernel_config kernel_opts = config.kernels["binmatmul_microtile"];
+
+    if (tile.x == 0 || tile.y == 0){
+        return std::unexpected{device_error::could_not_register_kernel};
+    }
+
+    struct KernelParams { 
+        u32 m; u32 n;
+        u32 k_bits; u32 k_words; 
+    } kernel_params { m, n, k_bits, k_words };
+
+    const std::array<u32, 2> micro_tile{ tile.y, tile.x };
+    auto kernel = ctx.register_kernel(kernel_opts, local_size, d_buffers, std::span<const u32>(micro_tile));
+    if (!kernel.has_value()){
+        ctx.exit();
+        return std::unexpected{kernel.error()};
+    }
+
+    constexpr std::array access{ buffer_access::read, buffer_access::read, buffer_access::write };
+
+    auto res = ctx.launch_kernel(
+        kernel.value(), 
+        grid_size, 
+        d_buffers, 
+        method, 
+        kernel_params,
+        std::span<const buffer_access>(access)
+    );
+
+    if (!res.has_value()){
+        ctx.destroy_kernel(kernel.value());
+        ctx.exit();
+        return std::unexpected{res.error()};
+    }
+
+    return {};
+}
+
+// Long-K binmatmul with one subgroup per element of C, reduced with subgroupAdd. local_size.x is split into
+// local_size.x / subgroup_size columns (specialization constant 3), local_size.y has to be 1:
+// grid = { ceil(n / (local.x / subgroup_size)), m, 1 }. Needs subgroup arithmetic (device_limits::subgroup).
+auto binmatmul_subgroup_vulkan_native_sequenced(
+    compute_context<device_driver::vulkan_native>& ctx,
+    application_config& config,
+    vec3<u32> grid_size,
+    vec3<u32> local_size,
+    u32 subgroup_size,
+    std::initializer_list<device_buffer<device_driver::vulkan_native>> d_buffers,
+    u32 m, u32 n, u32 k_bits, u32 k_words,
+    launch_method method = launch_method::sync
+) -> std::expected<void, device_error>{
+    kernel_config kernel_opts = config.kernels["binmatmul_subgroup"];
+
+    if (subgroup_size == 0 || local_size.y != 1 || local_size.z != 1 || local_size.x < subgroup_size){
+        return std::unexpected{device_error::could_not_register_kernel};
+    }
+
+    struct KernelParams { 
+        u32 m; u32 n;
+        u32 k_bits; u32 k_words; 
+    } kernel_params { m, n, k_bits, k_words };
+
+    const std::array<u32, 1> cols{ local_size.x / subgroup_size };
+    auto kernel = ctx.register_kernel(kernel_opts, local_size, d_buffers, std::span<const u32>(cols));
+    if (!kernel.has_value()){
+        ctx.exit();
+        return std::unexpected{kernel.error()};
+    }
+
+    constexpr std::array access{ buffer_access::read, buffer_access::read, buffer_access::write };
+
+    auto res = ctx.launch_kernel(
+        kernel.value(), 
+        grid_size, 
+        d_buffers, 
+        method, 
+        kernel_params,
+        std::span<const buffer_access>(access)
+    );
+
+    if (!res.has_value()){
+        ctx.destroy_kernel(kernel.value());
+        ctx.exit();
+        return std::unexpected{res.error()};
+    }
+
+    return {};
+}
+
+// Whether binmatmul of this shape takes the subgroup kernel on a device with these limits: K long enough that
+// one invocation per element would serialize it, few enough elements of C that the 2D kernels leave the device idle.
+// Decode shapes (m <= binmatmul_gemv_max_rows) stay on the GEMV kernel.
+auto binmatmul_prefers_subgroup(
+    const device_limits& limits,
+    u32 m, u32 n, u32 k_bits
+) -> bool {
+    return limits.subgroup.arithmetic && limits.subgroup_size != 0
+        && m > binmatmul_gemv_max_rows
+        && k_bits >= binmatmul_subgroup_min_k_bits
+        && static_cast<u64>(m) * n <= binmatmul_subgroup_max_outputs;
+}
+
+// Kernel choice and launch shape for a binmatmul of the given size on a device with `max_local`
+// work group dimensions. Decode shapes get the GEMV kernel with 128 invocations per workgroup (the
+// minimum every Vulkan device supports), the lanes per dot product shrink for short K so they are
+// not left idle. Everything else gets the 2D kernel with 16 x 16 workgroups, smaller along short edges.
+// `tile` is the block of C each 2D invocation computes (binmatmul_micro_tile for binmatmul_microtile), the
+// workgroups and grid are sized in units of it.
+struct binmatmul_launch_config {
+    bool gemv { false };
+    vec3<u32> grid_size { 1u, 1u, 1u };
+    vec3<u32> local_size { 1u, 1u, 1u };
+    vec2<u32> tile { 1u, 1u };
+};
+
+auto binmatmul_launch_geometry(
+    vec3<u32> max_local,
+    u32 m, u32 n, u32 k_words,
+    vec2<u32> tile = { 1u, 1u }
+) -> binmatmul_launch_config {
+    auto ceil_div = [](u32 value, u32 tile) {
+        return (value + tile - 1u) / tile;
+    };
+
+    if (m <= binmatmul_gemv_max_rows) {
+        const u32 lanes = std::bit_floor(std::max(1u, std::min({32u, max_local.x, std::bit_ceil(std::max(1u, k_words))})));
+        const u32 cols  = std::max(1u, std::min(128u / lanes, max_local.y));
+        return { true, {ceil_div(n, cols), m, 1u}, {lanes, cols, 1u} };
+    }
+
+    auto choose_tile = [](u32 dim, u32 preferred, u32 max_dim) {
+        u32 capped = std::min(preferred, max_dim);
+        if (dim >= capped) return capped;
+        if (dim >= 8) return 8u;
+        if (dim >= 4) return 4u;
+        if (dim >= 2) return 2u;
+        return 1u;
+    };
+
+    const u32 tiles_n = ceil_div(n, std::max(1u, tile.x));
+    const u32 tiles_m = ceil_div(m, std::max(1u, tile.y));
+    const u32 local_x = choose_tile(tiles_n, 16u, max_local.x);
+    const u32 local_y = choose_tile(tiles_m, 16u, max_local.y);
+    return { false, {ceil_div(tiles_n, local_x), ceil_div(tiles_m, local_y), 1u}, {local_x, local_y, 1u}, tile };
+}
+
+// Launch shape of binmatmul_subgroup: 128 invocations per workgroup (every Vulkan device supports them), at least
+// one full subgroup, so a workgroup covers 128 / subgroup_size columns of one row of C.
+auto binmatmul_subgroup_launch_geometry(
+    vec3<u32> max_local,
+    u32 subgroup_size,
+    u32 m, u32 n
+) -> binmatmul_launch_config {
+    const u32 lanes = std::max(1u, subgroup_size);
+    const u32 cols  = std::max(1u, std::min(128u, max_local.x) / lanes);
+    return { false, {(n + cols - 1u) / cols, m, 1u}, {cols * lanes, 1u, 1u} };
+}
+
 // template<typename T> 
 // auto binmatmul_vulkan_native_standalone(
 //     compute_context<device_driver::vulkan_native>& ctx,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <expected>
 #include <concepts>
@@ -40,12 +41,66 @@ auto fill_vulkan_native_sequenced(
         return std::unexpected{kernel.error()};
     }
 
+    constexpr std::array access{ buffer_access::write };
+
     auto res = ctx.launch_kernel(
         kernel.value(), 
         work_group_size, 
         {d_buff}, 
         launch_method::sync, 
-        kernel_params
+        kernel_params,
+        std::span<const buffer_access>(access)
+    );
+
+    if (!res.has_value()){
+        ctx.destroy_kernel(kernel.value());
+        ctx.exit();
+        return std::unexpected{res.error()};
+    }
+
+    return {};
+}
+
+// fill on buffer_address binding: the buffer is passed as a device address, offset_bytes starts the
+// range at any element inside it. Needs device_limits::buffer_device_address and a Vulkan 1.2 context.
+template<typename T> 
+auto fill_bda_vulkan_native_sequenced(
+    compute_context<device_driver::vulkan_native>& ctx,
+    application_config& config,
+    vec3<u32> work_group_size,
+    device_buffer<device_driver::vulkan_native>& d_buff,
+    T fill_value,
+    usize offset_bytes = 0
+) -> std::expected<void, device_error>{
+    // fill_bda.comp.glsl works on float elements behind a 16-byte push constant block
+    static_assert(std::same_as<T, f32>, "fill_bda only supports f32 buffers");
+
+    kernel_config kernel_opts = config.kernels["fill_bda"];
+
+    if (offset_bytes > d_buff.size_bytes || offset_bytes % sizeof(T) != 0 || d_buff.address == 0){
+        return std::unexpected{device_error::launch_failed};
+    }
+
+    struct KernelParams { 
+        u64 address; T value; u32 count; 
+    } kernel_params { d_buff.address + offset_bytes, fill_value, static_cast<u32>((d_buff.size_bytes - offset_bytes) / sizeof(T)) };
+    static_assert(sizeof(KernelParams) == 16);
+
+    auto kernel = ctx.register_kernel(kernel_opts, work_group_size, {d_buff});
+    if (!kernel.has_value()){
+        ctx.exit();
+        return std::unexpected{kernel.error()};
+    }
+
+    constexpr std::array access{ buffer_access::write };
+
+    auto res = ctx.launch_kernel(
+        kernel.value(), 
+        work_group_size, 
+        {d_buff}, 
+        launch_method::sync, 
+        kernel_params,
+        std::span<const buffer_access>(access)
     );
 
     if (!res.has_value()){
@@ -107,8 +162,7 @@ auto fill_vulkan_native_standalone(
         return std::unexpected{res.error()};
     }
 
-    ctx.destroy_kernel(kernel.value());
-
+    // The kernel stays registered in ctx for the next call, exit() releases it
     return {};
 }
 
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <expected>
+#include <concepts>
+#include <span>
+
+#include "../../types.hpp"
+#include "../../context.hpp"
+
+namespace tether_io{
+
+/*
+Buffers: A and B hold (sign, nonzero) u32 pairs from f32_mat_to_packed_ternary_u32, C is i32 [m x n].
+
+layout(push_constant) uniform PushConsts {
+    uint M;        // rows of A / C
+    uint N;        // cols of B / C
+    uint K_bits;   // common dimension in weights (not words)
+    uint K_words;  // K_bits / 32 rounded up, number of plane pairs per row
+} pc;
+*/
+
+auto ternmatmul_vulkan_native_sequenced(
+    compute_context<device_driver::vulkan_native>& ctx,
+    application_config& config,
+    vec3<u32> grid_size,
+    vec3<u32> local_size,
+    std::initializer_list<device_buffer<device_driver::vulkan_native>> d_buffers,
+    u32 m, u32 n, u32 k_bits, u32 k_words
+) -> std::expected<void, device_error>{
+    kernel_config kernel_opts = config.kernels["ternmatmul"];
+
+    struct KernelParams { 
+        u32 m; u32 n;
+        u32 k_bits; u32 k_words; 
+    } kernel_params { m, n, k_bits, k_words };
+
+    auto kernel = ctx.register_kernel(kernel_opts, local_size, d_buffers);
+    if (!kernel.has_value()){
+        ctx.exit();
+        return std::unexpected{kernel.error()};
+    }
+
+    constexpr std::array access{ buffer_access::read, buffer_access::read, buffer_access::write };
+
+    auto res = ctx.launch_kernel(
+        kernel.value(), 
+        grid_size, 
+        d_buffers, 
+        launch_method::sync, 
+        kernel_params,
+        std::span<const buffer_access>(access)
+    );
+
+    if (!res.has_value()){
+        ctx.destroy_kernel(kernel.value());
+        ctx.exit();
+        return std::unexpected{res.error()};
+    }
+
+    return {};
+}
+
+}
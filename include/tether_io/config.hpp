@@ -64,6 +64,12 @@ auto kernel_format_from_str(str value) -> std::expected<kernel_format, json_erro
     return std::unexpected{ json_error::invalid_value_type };
 };
 
+auto binding_model_from_str(str value) -> std::expected<binding_model, json_error>{
+    if (value == "descriptors") return binding_model::descriptors;
+    if (value == "buffer_address") return binding_model::buffer_address;
+    return std::unexpected{ json_error::invalid_value_type };
+};
+
 auto kernel_bin_format_from_kernel_type(kernel_type value) -> kernel_format {
     switch(value){
         case kernel_type::vulkan_compute_shader: return kernel_format::spirv;
@@ -136,6 +142,13 @@ inline auto parse_application_settings(std::filesystem::path path) -> std::expec
             krnl.type_version = entry["version"].get<version<u32>>();
             krnl.param_size_bytes = entry["param_size_bytes"].get<usize>();
 
+            // Optional, kernels without it bind their buffers through descriptors
+            if (entry.contains("binding_model")){
+                auto binding = binding_model_from_str(entry["binding_model"].get<str>());
+                if (!binding.has_value()) return std::unexpected{binding.error()};
+                krnl.binding = binding.value();
+            }
+
             krnl.path = cfg.kernel_dir / entry["file"].get<str>();
             str bin_file_name = entry["name"].get<str>() + file_type_from_kernel_format(cfg.kernel_bin_format);
             krnl.path_bin = cfg.kernel_dir / "bin" / bin_file_name;
@@ -147,6 +160,18 @@ inline auto parse_application_settings(std::filesystem::path path) -> std::expec
         }
     }
 
+    // Optional, points an algorithm at an alternative kernel entry, e.g. "binmatmul": "binmatmul_tiled"
+    if (kernel_settings.contains("variants")){
+        if (!kernel_settings["variants"].is_object()) return std::unexpected{ json_error::invalid_value_type };
+
+        for (const auto& [algorithm, selected] : kernel_settings["variants"].items()) {
+            if (!selected.is_string() || !cfg.kernels.contains(selected.get<str>())){
+                return std::unexpected{ json_error::invalid_value_type };
+            }
+            cfg.variants[algorithm] = selected.get<str>();
+        }
+    }
+
     return cfg;
 
 }
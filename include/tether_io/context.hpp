@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <expected>
+#include <span>
 
 #include "types.hpp"
 
@@ -43,7 +44,7 @@ struct compute_context{
     template<typename... Args>
     auto allocate(
         usize size_bytes, 
-        alloc_method method = alloc_method::default, 
+        alloc_method method = alloc_method::base,
         Args&&... opts
     ) -> std::expected<device_buffer<D>, device_error> {
         auto result = driver.allocate(size_bytes, method, opts...);
@@ -75,6 +76,63 @@ struct compute_context{
         return {};
     };
 
+    template<typename T>
+    auto upload_async(
+        device_buffer<D>& dest,
+        std::span<T> src
+    ) -> std::expected<transfer<D>, device_error> {
+        auto result = driver.upload_async(dest, src);
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return result.value();
+    };
+
+    template<typename T>
+    auto download_async(
+        std::span<T> dest,
+        device_buffer<D>& src
+    ) -> std::expected<transfer<D>, device_error> {
+        auto result = driver.download_async(dest, src);
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return result.value();
+    };
+
+    auto wait_for_transfer(const transfer<D>& handle, usize time_out) -> std::expected<void, device_error> {
+        auto result = driver.wait_for_transfer(handle, time_out);
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return {};
+    };
+
+    auto wait_for_transfers(usize time_out) -> std::expected<void, device_error> {
+        auto result = driver.wait_for_transfers(time_out);
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return {};
+    };
+
+    auto transfer_complete(const transfer<D>& handle) -> bool {
+        return driver.transfer_complete(handle);
+    };
+
+    auto free(device_buffer<D>& buff) -> std::expected<void, device_error> {
+        auto result = driver.free(buff);
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return {};
+    };
+
+    auto pool_stats() const -> memory_pool_stats {
+        return driver.pool_stats();
+    };
+
+    auto trim_pool() -> void {
+        driver.trim_pool();
+    };
+
+    template<typename T>
+    auto map(device_buffer<D>& buff) -> std::expected<std::span<T>, device_error> {
+        auto result = driver.template map<T>(buff);
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return result.value();
+    };
+
     template<typename... Args>
     auto register_kernel(
         kernel_config& krnl_opts, 
@@ -100,6 +158,86 @@ struct compute_context{
         return {};
     };
 
+    template<class_type KernelParams>
+    auto launch_kernel_async(
+        kernel<D>& task,
+        vec3<u32> workgroup_size,
+        std::initializer_list<device_buffer<D>> buffers,
+        KernelParams kernel_params
+    ) -> std::expected<launch_token<D>, device_error> {
+        auto result = driver.launch_kernel_async(task, workgroup_size, buffers, kernel_params);
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return result.value();
+    };
+
+    auto poll(const launch_token<D>& token) -> bool {
+        return driver.poll(token);
+    }
+
+    auto wait_for_launch(const launch_token<D>& token, usize time_out) -> std::expected<void, device_error> {
+        auto result = driver.wait_for_launch(token, time_out);
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return {};
+    }
+
+    auto wait_any(std::span<const launch_token<D>> tokens, usize time_out) -> std::expected<usize, device_error> {
+        auto result = driver.wait_any(tokens, time_out);
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return result.value();
+    }
+
+    auto wait_all(std::span<const launch_token<D>> tokens, usize time_out) -> std::expected<void, device_error> {
+        auto result = driver.wait_all(tokens, time_out);
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return {};
+    }
+
+    auto begin_sequence() -> std::expected<void, device_error> {
+        auto result = driver.begin_sequence();
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return {};
+    }
+
+    auto submit_sequence() -> std::expected<launch_token<D>, device_error> {
+        auto result = driver.submit_sequence();
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return result.value();
+    }
+
+    auto cancel_sequence() -> void {
+        driver.cancel_sequence();
+    }
+
+    auto recording() const -> bool {
+        return driver.recording();
+    }
+
+    auto sequence_statistics() const -> sequence_stats {
+        return driver.sequence_statistics();
+    }
+
+    auto begin_capture() -> std::expected<void, device_error> {
+        auto result = driver.begin_capture();
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return {};
+    }
+
+    auto end_capture() -> std::expected<command_graph<D>, device_error> {
+        auto result = driver.end_capture();
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return result.value();
+    }
+
+    auto replay(const command_graph<D>& graph) -> std::expected<launch_token<D>, device_error> {
+        auto result = driver.replay(graph);
+        if (!result.has_value()) return std::unexpected{ result.error() };
+        return result.value();
+    }
+
+    void destroy_graph(command_graph<D>& graph){
+        driver.destroy_graph(graph);
+    }
+
     template<typename... Args>
     auto wait_for_kernel(
         kernel<D>& task, 
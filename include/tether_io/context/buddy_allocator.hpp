@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <expected>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "../types.hpp"
+
+namespace tether_io{
+
+// Power-of-two buddy allocator over the byte range [0, capacity) of one device memory block.
+//
+// A request is rounded up to the next power of two (at least min_block and at least its alignment),
+// so every returned offset is aligned to its own rounded size and therefore to the requested alignment.
+// Freed blocks merge with their buddy as long as the buddy is free too, which keeps external
+// fragmentation bounded without a compaction step. The allocator only does bookkeeping, the owner maps
+// offsets onto VkDeviceMemory (or anything else).
+class buddy_allocator {
+public:
+    buddy_allocator(usize capacity, usize min_block)
+        : min_block(std::bit_ceil(std::max<usize>(min_block, 1))),
+          capacity(std::bit_ceil(std::max(capacity, this->min_block))) {
+        const usize orders = std::countr_zero(this->capacity / this->min_block) + 1;
+        free_lists.resize(orders);
+        free_lists.back().insert(0);
+    }
+
+    auto allocate(usize size_bytes, usize alignment = 1) -> std::expected<usize, device_error> {
+        const usize rounded = std::bit_ceil(std::max({ size_bytes, min_block, alignment }));
+        if (size_bytes == 0 || rounded > capacity) {
+            return std::unexpected{device_error::alloc_failed};
+        }
+
+        const usize order = order_of(rounded);
+
+        // Smallest free block that fits, split down to the requested order
+        usize from = order;
+        while (from < free_lists.size() && free_lists[from].empty()) ++from;
+        if (from == free_lists.size()) {
+            return std::unexpected{device_error::alloc_failed};
+        }
+
+        const usize offset = *free_lists[from].begin();
+        free_lists[from].erase(free_lists[from].begin());
+        while (from > order) {
+            --from;
+            free_lists[from].insert(offset + (min_block << from));
+        }
+
+        allocations.emplace(offset, allocation{ static_cast<u32>(order), size_bytes });
+        used_bytes += rounded;
+        requested_bytes += size_bytes;
+        return offset;
+    }
+
+    auto free(usize offset) -> bool {
+        auto it = allocations.find(offset);
+        if (it == allocations.end()) return false;
+
+        usize order = it->second.order;
+        used_bytes -= min_block << order;
+        requested_bytes -= it->second.size_bytes;
+        allocations.erase(it);
+
+        // Merge with the buddy while it is free
+        while (order + 1 < free_lists.size()) {
+            const usize buddy = offset ^ (min_block << order);
+            auto buddy_it = free_lists[order].find(buddy);
+            if (buddy_it == free_lists[order].end()) break;
+
+            free_lists[order].erase(buddy_it);
+            offset = std::min(offset, buddy);
+            ++order;
+        }
+        free_lists[order].insert(offset);
+        return true;
+    }
+
+    auto capacity_bytes() const -> usize { return capacity; }
+    auto used() const -> usize { return used_bytes; }           // rounded sizes of live allocations
+    auto requested() const -> usize { return requested_bytes; } // sizes the callers asked for
+    auto allocation_count() const -> usize { return allocations.size(); }
+    auto empty() const -> bool { return allocations.empty(); }
+
+    auto largest_free_block() const -> usize {
+        for (usize order = free_lists.size(); order-- > 0;) {
+            if (!free_lists[order].empty()) return min_block << order;
+        }
+        return 0;
+    }
+
+private:
+    struct allocation {
+        u32 order;
+        usize size_bytes;
+    };
+
+    usize min_block;
+    usize capacity;
+    usize used_bytes = 0;
+    usize requested_bytes = 0;
+
+    std::vector<std::set<usize>> free_lists;              // free block offsets per order (size = min_block << order)
+    std::unordered_map<usize, allocation> allocations;    // live allocations by offset
+
+    auto order_of(usize rounded) const -> usize {
+        return std::countr_zero(rounded / min_block);
+    }
+};
+
+}; // namespace tether_io
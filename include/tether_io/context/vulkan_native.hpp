@@ -10,12 +10,28 @@
 #include <vector>
 #include <array>
 #include <limits>
+#include <map>
 #include <cstring>
+#include <algorithm>
+#include <bit>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
 
 #include <vulkan/vulkan.hpp>
+
+// Runtime GLSL compilation is optional, builds with embedded kernels can drop shaderc (TETHER_IO_USE_SHADERC=OFF)
+#ifdef USE_SHADERC
 #include <shaderc/shaderc.hpp>
+#endif // USE_SHADERC
+
+// SPIR-V compiled at build time by cmake/EmbedShaders.cmake
+#ifdef TETHER_IO_EMBEDDED_KERNELS
+#include <tether_io_embedded_kernels.hpp>
+#endif // TETHER_IO_EMBEDDED_KERNELS
 
 #include "../types.hpp"
+#include "buddy_allocator.hpp"
 
 namespace tether_io{
 
@@ -23,6 +39,27 @@ namespace tether_io{
         VkBuffer buff_handle{}; 
         VkDeviceMemory memory_handle{}; 
         usize size_bytes{};
+        bool host_visible{true}; // false: device-local, uploads and downloads go through the staging buffer
+        void* mapped{};          // host-visible memory stays mapped from allocation until exit
+        usize offset{};          // byte offset inside memory_handle, non-zero only for pooled buffers
+        u32 pool_block{~0u};     // index of the pool block for alloc_method::custom, ~0u for dedicated memory
+        VkDeviceAddress address{}; // GPU pointer for binding_model::buffer_address kernels, 0 without the feature
+    };
+
+    // Value the transfer timeline reaches once the copy (and for downloads the copy into host memory) is done,
+    // 0 when the transfer already completed on return.
+    template<> struct transfer<device_driver::vulkan_native>{
+        u64 timeline_value{};
+    };
+
+    // Completion token of a launch_method::async launch, serial 0 means nothing to wait for
+    template<> struct launch_token<device_driver::vulkan_native>{
+        u64 serial{};
+    };
+
+    // Handle of a captured command graph, id 0 is no graph
+    template<> struct command_graph<device_driver::vulkan_native>{
+        u64 id;
     };
 
     template<> struct kernel<device_driver::vulkan_native>{
@@ -30,9 +67,9 @@ namespace tether_io{
         VkPipeline pipeline{};
         VkPipelineLayout pipeline_layout{};
         VkDescriptorSetLayout descriptor_layout{};
-        VkDescriptorPool descriptor_pool{};
-        VkDescriptorSet descriptor{};
+        VkDescriptorSet descriptor{}; // cached set of the launch being recorded, unused with push descriptors
         VkCommandBuffer command_buffer{};
+        binding_model binding{};      // buffer_address: no descriptor layout, buffers arrive as push-constant pointers
     };
 
     struct vulkan_native_driver {
@@ -106,6 +143,19 @@ namespace tether_io{
                     }
                     break;
                 }
+                case alloc_method::device_local : {
+                    if(!create_buffer_device_local(buff)){
+                        return std::unexpected { device_error::could_not_create_buffer };
+                    }
+                    break;
+                }
+                case alloc_method::custom : {
+                    auto res = create_buffer_pooled(buff);
+                    if(!res.has_value()){
+                        return std::unexpected { res.error() };
+                    }
+                    break;
+                }
                 default : { return std::unexpected{ device_error::alloc_failed }; }
 
             }
@@ -128,6 +178,14 @@ namespace tether_io{
                     }
                     break;
                 }
+                case upload_method::async : {
+                    // Later launches and downloads of dest are ordered after the copy by the timelines
+                    auto res = upload_async(dest, src);
+                    if(!res.has_value()){
+                        return std::unexpected{ res.error() };
+                    }
+                    break;
+                }
                 default: {return std::unexpected{ device_error::upload_failed }; }
 
             }
@@ -150,6 +208,14 @@ namespace tether_io{
                     }
                     break;
                 }
+                case download_method::async: {
+                    // dest is filled by the next wait_for_transfers() (or a wait on a later transfer)
+                    auto res = download_async(dest, src);
+                    if(!res.has_value()){
+                        return std::unexpected{ res.error() };
+                    }
+                    break;
+                }
                 default: { return std::unexpected{ device_error::download_failed }; }
             };
 
@@ -157,6 +223,170 @@ namespace tether_io{
 
         }
 
+        // Queues a copy of src into dest on the transfer queue and returns without waiting. The copy waits for
+        // dispatches still using dest and every later launch that binds dest waits for the copy, both on the GPU
+        // through timeline semaphores, so uploads for the next layer overlap with the current one's compute.
+        // src is copied into staging memory before returning and can be reused right away. Host-visible buffers
+        // are written directly and complete immediately.
+        template<typename T>
+        auto upload_async(
+            device_buffer<device_driver::vulkan_native>& dest,
+            std::span<T> src
+        ) -> std::expected<transfer<device_driver::vulkan_native>, device_error> {
+            if (src.size_bytes() > dest.size_bytes){
+                return std::unexpected{ device_error::upload_failed };
+            }
+
+            if (!timeline_semaphores || dest.host_visible || src.size_bytes() == 0){
+                if(!upload_buffer_sync(dest, src)){
+                    return std::unexpected{ device_error::upload_failed };
+                }
+                return transfer<device_driver::vulkan_native>{};
+            }
+
+            auto slot = acquire_staging_slot(src.size_bytes());
+            if (!slot.has_value()) return std::unexpected{ device_error::upload_failed };
+
+            auto& staging = staging_slots[slot.value()];
+            std::memcpy(staging.buff.mapped, src.data(), src.size_bytes());
+
+            auto value = submit_transfer(staging, dest, src.size_bytes(), true);
+            if (!value.has_value()) return std::unexpected{ device_error::upload_failed };
+
+            buffer_syncs[dest.buff_handle].transfer_value = value.value();
+            return transfer<device_driver::vulkan_native>{ value.value() };
+        }
+
+        // Queues a copy of src into dest that starts once the dispatches writing src have finished. dest must
+        // stay alive until the returned transfer is waited on, the wait copies the data into it.
+        template<typename T>
+        auto download_async(
+            std::span<T> dest,
+            device_buffer<device_driver::vulkan_native>& src
+        ) -> std::expected<transfer<device_driver::vulkan_native>, device_error> {
+            if (dest.size_bytes() > src.size_bytes){
+                return std::unexpected{ device_error::download_failed };
+            }
+
+            if (!timeline_semaphores || dest.size_bytes() == 0){
+                if(!download_buffer_sync(dest, src)){
+                    return std::unexpected{ device_error::download_failed };
+                }
+                return transfer<device_driver::vulkan_native>{};
+            }
+
+            std::expected<u64, device_error> value = std::unexpected{ device_error::download_failed };
+            const void* host_src = src.mapped;
+            if (src.host_visible){
+                // Nothing to copy on the GPU, the empty submission only waits for the writers of src
+                value = submit_transfer_wait(buffer_syncs[src.buff_handle].compute_value);
+            } else {
+                auto slot = acquire_staging_slot(dest.size_bytes());
+                if (!slot.has_value()) return std::unexpected{ device_error::download_failed };
+
+                auto& staging = staging_slots[slot.value()];
+                host_src = staging.buff.mapped;
+                value = submit_transfer(staging, src, dest.size_bytes(), false);
+            }
+            if (!value.has_value() || host_src == nullptr) return std::unexpected{ device_error::download_failed };
+
+            pending_downloads.push_back(pending_download{ value.value(), host_src, dest.data(), dest.size_bytes() });
+            return transfer<device_driver::vulkan_native>{ value.value() };
+        }
+
+        auto wait_for_transfer(
+            const transfer<device_driver::vulkan_native>& handle, usize time_out
+        ) -> std::expected<void, device_error> {
+            if (handle.timeline_value != 0){
+                VkSemaphoreWaitInfo swi{VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+                swi.semaphoreCount = 1;
+                swi.pSemaphores = &transfer_timeline;
+                swi.pValues = &handle.timeline_value;
+                if (vkWaitSemaphores(device_handle, &swi, time_out) != VK_SUCCESS){
+                    return std::unexpected{device_error::transfer_timeout_reached};
+                }
+            }
+
+            retire_transfers();
+            return {};
+        }
+
+        // Waits for every transfer queued so far and completes their downloads
+        auto wait_for_transfers(usize time_out) -> std::expected<void, device_error> {
+            return wait_for_transfer(transfer<device_driver::vulkan_native>{ transfer_value }, time_out);
+        }
+
+        // Non-blocking check, completes the downloads that have landed
+        auto transfer_complete(const transfer<device_driver::vulkan_native>& handle) -> bool {
+            return retire_transfers() >= handle.timeline_value;
+        }
+
+        // Releases a buffer from any alloc_method. Pooled memory goes back to its block, dedicated memory is
+        // freed. The caller has to make sure no pending kernel still uses the buffer.
+        auto free(
+            device_buffer<device_driver::vulkan_native>& buff
+        ) -> std::expected<void, device_error> {
+            auto it = std::find_if(buffer_states.begin(), buffer_states.end(), [&](const auto& b){
+                return b.buff_handle == buff.buff_handle;
+            });
+            if (buff.buff_handle == VK_NULL_HANDLE || it == buffer_states.end()){
+                return std::unexpected{device_error::not_available};
+            }
+
+            buffer_syncs.erase(it->buff_handle);
+            evict_descriptor_sets(it->buff_handle);
+            release_buffer(*it);
+            buffer_states.erase(it);
+            buff = device_buffer<device_driver::vulkan_native>{};
+            return {};
+        }
+
+        auto pool_stats() const -> memory_pool_stats {
+            memory_pool_stats stats{};
+            usize free_bytes = 0;
+            usize largest_free = 0;
+            for (const auto& block : pool_blocks){
+                // Released by trim_pool, the slot only waits for reuse
+                if (block.memory == VK_NULL_HANDLE) continue;
+                stats.block_count += 1;
+                stats.reserved_bytes += block.allocator.capacity_bytes();
+                stats.in_use_bytes += block.allocator.used();
+                stats.requested_bytes += block.allocator.requested();
+                stats.allocation_count += block.allocator.allocation_count();
+                free_bytes += block.allocator.capacity_bytes() - block.allocator.used();
+                largest_free = std::max(largest_free, block.allocator.largest_free_block());
+            }
+            stats.fragmentation = free_bytes == 0 ? 0.0 : 1.0 - static_cast<f64>(largest_free) / static_cast<f64>(free_bytes);
+            return stats;
+        }
+
+        // Returns pool blocks without live sub-allocations to the driver
+        auto trim_pool() -> void {
+            for (auto& block : pool_blocks){
+                if (block.memory != VK_NULL_HANDLE && block.allocator.empty()){
+                    vkFreeMemory(device_handle, block.memory, nullptr);
+                    block.memory = VK_NULL_HANDLE;
+                }
+            }
+            // Indices are stored in buffers, only trailing released blocks can be dropped
+            while (!pool_blocks.empty() && pool_blocks.back().memory == VK_NULL_HANDLE){
+                pool_blocks.pop_back();
+            }
+        }
+
+        // View of a host-visible buffer's persistent mapping. Writes through the span are what the next dispatch
+        // reads (the memory is coherent), so packers can fill a buffer in place without a host vector and upload.
+        template<typename T>
+        auto map(
+            device_buffer<device_driver::vulkan_native>& buff
+        ) -> std::expected<std::span<T>, device_error> {
+            if (buff.mapped == nullptr){
+                return std::unexpected{device_error::buffer_not_mappable};
+            }
+
+            return std::span<T>(static_cast<T*>(buff.mapped), buff.size_bytes / sizeof(T));
+        }
+
         auto limits() -> std::expected<device_limits, device_error>{
             if (device == VK_NULL_HANDLE){
                 return std::unexpected{device_error::not_available};
@@ -171,39 +401,93 @@ namespace tether_io{
                 props.limits.maxComputeWorkGroupSize[1],
                 props.limits.maxComputeWorkGroupSize[2]
             };
+            out.unified_memory = unified_memory;
+            out.async_transfers = timeline_semaphores;
+            out.dedicated_transfer_queue = transfer_family != queue_family;
+            out.push_descriptors = push_descriptors;
+            out.buffer_device_address = buffer_device_address;
+
+            // Subgroup properties are core in 1.1, they only count if compute shaders can use them
+            const u32 requested_api = VK_MAKE_API_VERSION(api_version.variant, api_version.major, api_version.minor, 0);
+            if (props.apiVersion >= VK_API_VERSION_1_1 && requested_api >= VK_API_VERSION_1_1){
+                VkPhysicalDeviceSubgroupProperties subgroup{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES};
+                VkPhysicalDeviceProperties2 props2{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+                props2.pNext = &subgroup;
+                vkGetPhysicalDeviceProperties2(device, &props2);
+
+                if ((subgroup.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT) != 0){
+                    const auto ops = subgroup.supportedOperations;
+                    out.subgroup_size = subgroup.subgroupSize;
+                    out.subgroup.basic            = (ops & VK_SUBGROUP_FEATURE_BASIC_BIT) != 0;
+                    out.subgroup.vote             = (ops & VK_SUBGROUP_FEATURE_VOTE_BIT) != 0;
+                    out.subgroup.arithmetic       = (ops & VK_SUBGROUP_FEATURE_ARITHMETIC_BIT) != 0;
+                    out.subgroup.ballot           = (ops & VK_SUBGROUP_FEATURE_BALLOT_BIT) != 0;
+                    out.subgroup.shuffle          = (ops & VK_SUBGROUP_FEATURE_SHUFFLE_BIT) != 0;
+                    out.subgroup.shuffle_relative = (ops & VK_SUBGROUP_FEATURE_SHUFFLE_RELATIVE_BIT) != 0;
+                    out.subgroup.clustered        = (ops & VK_SUBGROUP_FEATURE_CLUSTERED_BIT) != 0;
+                    out.subgroup.quad             = (ops & VK_SUBGROUP_FEATURE_QUAD_BIT) != 0;
+                }
+            }
 
             return out;
         }
 
+        // Kernels are built once per (name, workgroup size, specialization constants, binding count) and
+        // kept in a registry until exit(), later calls return the cached pipeline. `specialization` holds the
+        // constants after the three workgroup-size ones (constant_id 3, 4, ...).
         auto register_kernel(
             kernel_config& krnl_opts, 
             vec3<u32> workgroup_size,
-            std::initializer_list<device_buffer<device_driver::vulkan_native>> buffers
+            std::initializer_list<device_buffer<device_driver::vulkan_native>> buffers,
+            std::span<const u32> specialization = {}
         ) -> std::expected<kernel<device_driver::vulkan_native>, device_error> {
             kernel<device_driver::vulkan_native> krnl;
 
             if (!is_valid_workgroup_size(workgroup_size)){
                 return std::unexpected{device_error::could_not_register_kernel};
             }
+            if (krnl_opts.binding == binding_model::buffer_address && !buffer_device_address){
+                return std::unexpected{device_error::shader_version_or_type_not_supported};
+            }
 
-            if (krnl_opts.recompile){
-                switch(krnl_opts.format){
-                    case kernel_format::glsl : {
-                        if (krnl_opts.type_version != api_version){
-                            return std::unexpected{device_error::shader_version_or_type_not_supported};
-                        }
+            const str key = kernel_registry_key(krnl_opts.name, workgroup_size, specialization, buffers.size());
+            if (auto cached = kernel_registry.find(key); cached != kernel_registry.end()){
+                return cached->second;
+            }
 
-                        auto shader_bin = compile_glsl_to_spv(krnl_opts);
-                        if(!shader_bin.has_value()) return std::unexpected{shader_bin.error()};
-                        
-                        auto res = register_spv_to_pipeline(krnl_opts, buffers, shader_bin.value(), krnl, workgroup_size);
-                        if(!res.has_value()) return std::unexpected{res.error()};
+            open_pipeline_cache(krnl_opts.path_bin.parent_path());
 
-                        break;
+            std::expected<std::vector<u32>, device_error> shader_bin;
+            switch(krnl_opts.format){
+                case kernel_format::glsl : {
+                    // SPIR-V targeting an older Vulkan runs on newer instances, only newer targets are rejected
+                    if (krnl_opts.type_version > api_version){
+                        return std::unexpected{device_error::shader_version_or_type_not_supported};
+                    }
+
+                    // With recompile, always run shaderc on the current source. Otherwise the build-time binary
+                    // first (no filesystem or compiler work), then path_bin while its hash matches the source.
+                    if (krnl_opts.recompile){
+                        shader_bin = compile_glsl_to_spv(krnl_opts);
+                    } else if (auto embedded = find_embedded_spv(krnl_opts); !embedded.empty()){
+                        shader_bin = std::vector<u32>(embedded.begin(), embedded.end());
+                    } else {
+                        shader_bin = load_or_compile_spv(krnl_opts);
                     }
-                    default : { return std::unexpected{device_error::could_not_register_kernel}; }
+                    break;
+                }
+                case kernel_format::spirv : {
+                    shader_bin = read_spv_file(krnl_opts.path);
+                    break;
                 }
+                default : { return std::unexpected{device_error::could_not_register_kernel}; }
             }
+            if(!shader_bin.has_value()) return std::unexpected{shader_bin.error()};
+
+            auto res = register_spv_to_pipeline(krnl_opts, buffers, shader_bin.value(), krnl, workgroup_size, specialization);
+            if(!res.has_value()) return std::unexpected{res.error()};
+
+            kernel_registry.emplace(key, krnl);
 
             return krnl;
         };
@@ -214,7 +498,8 @@ namespace tether_io{
             vec3<u32> workgroup_size,
             std::initializer_list<device_buffer<device_driver::vulkan_native>> buffers,
             launch_method method,
-            KernelParams kernel_params
+            KernelParams kernel_params,
+            std::span<const buffer_access> access = {}
         ) -> std::expected<void, device_error> {
             
             
@@ -222,63 +507,298 @@ namespace tether_io{
                 return std::unexpected{device_error::could_not_register_kernel};
             }
 
+            // Between begin_sequence() and submit_sequence() every launch is appended to the sequence
+            if (sequence.active){
+                return record_launch(task, workgroup_size, buffers, kernel_params, access);
+            }
+
             switch(method){
                 case launch_method::sync: {
-                    if(!update_descriptor_sets(task, buffers)){
-                        return std::unexpected{device_error::could_not_update_descriptors}; 
+                    // Registered kernels are shared, the previous submission has to finish before the
+                    // command buffer is rewritten
+                    if(task.lock != VK_NULL_HANDLE && vkWaitForFences(device_handle, 1, &task.lock, VK_TRUE, std::numeric_limits<u64>::max()) != VK_SUCCESS){
+                        return std::unexpected{device_error::kernel_timout_reached};
                     }
 
-                    if(!dispatch_kernel_to_command_buffer(task, workgroup_size, kernel_params)){
-                        return std::unexpected{device_error::could_not_dispatch_kernel_to_command_buffer}; 
-                    }
+                    auto res = submit_launch(task, workgroup_size, buffers, kernel_params);
+                    if(!res.has_value()) return std::unexpected{res.error()};
 
+                    last_kernel = task;
+                    last_launch = {};
+                    break;
+                }
+                case launch_method::async: {
+                    // wait_for_last_kernel() covers it, launch_kernel_async() returns the token
+                    auto token = launch_kernel_async(task, workgroup_size, buffers, kernel_params);
+                    if(!token.has_value()) return std::unexpected{token.error()};
                     break;
                 }
                 default: { return std::unexpected{device_error::launch_failed}; }
             }
-
-            last_kernel = task;
             
             return {};
         };
 
+        // Records and submits the launch without waiting for earlier launches of the same kernel: each in-flight
+        // launch gets its own command buffer and fence, taken from per-kernel slots and the fence pool and
+        // recycled once the launch has retired. Any number of launches can be in flight.
+        template<class_type KernelParams>
+        auto launch_kernel_async(
+            kernel<device_driver::vulkan_native>& task,
+            vec3<u32> workgroup_size,
+            std::initializer_list<device_buffer<device_driver::vulkan_native>> buffers,
+            KernelParams kernel_params
+        ) -> std::expected<launch_token<device_driver::vulkan_native>, device_error> {
+            if (!is_valid_workgroup_size(workgroup_size) || task.pipeline == VK_NULL_HANDLE){
+                return std::unexpected{device_error::launch_failed};
+            }
+
+            retire_launches();
+
+            auto slot_idx = acquire_launch_slot(task);
+            if (!slot_idx.has_value()) return std::unexpected{slot_idx.error()};
+            auto fence = acquire_fence();
+            if (!fence.has_value()) return std::unexpected{fence.error()};
+
+            auto& slot = launch_slots[task.pipeline][slot_idx.value()];
+
+            // Same pipeline, the slot's per-launch objects
+            kernel<device_driver::vulkan_native> slot_task = task;
+            slot_task.command_buffer = slot.command_buffer;
+            slot_task.lock = fence.value();
+
+            auto res = submit_launch(slot_task, workgroup_size, buffers, kernel_params);
+            if (!res.has_value()){
+                free_fences.push_back(fence.value());
+                return std::unexpected{res.error()};
+            }
+
+            slot.busy = true;
+            const launch_token<device_driver::vulkan_native> token{ ++launch_serial };
+            in_flight.push_back(in_flight_launch{ token.serial, fence.value(), { task.pipeline }, slot_idx.value(), VK_NULL_HANDLE });
+            last_launch = token;
+            return token;
+        }
+
+        // Non-blocking: true once the launch has finished (retired launches are always complete)
+        auto poll(const launch_token<device_driver::vulkan_native>& token) -> bool {
+            retire_launches();
+            return find_in_flight(token) == in_flight.end();
+        }
+
+        auto wait_for_launch(
+            const launch_token<device_driver::vulkan_native>& token, usize time_out
+        ) -> std::expected<void, device_error> {
+            return wait_all(std::span<const launch_token<device_driver::vulkan_native>>(&token, 1), time_out);
+        }
+
+        auto wait_all(
+            std::span<const launch_token<device_driver::vulkan_native>> tokens, usize time_out
+        ) -> std::expected<void, device_error> {
+            auto fences = in_flight_fences(tokens);
+            if (!fences.empty() &&
+                vkWaitForFences(device_handle, static_cast<u32>(fences.size()), fences.data(), VK_TRUE, time_out) != VK_SUCCESS){
+                return std::unexpected{device_error::kernel_timout_reached};
+            }
+
+            retire_launches();
+            return {};
+        }
+
+        // Index in tokens of a launch that has finished, waiting until one does
+        auto wait_any(
+            std::span<const launch_token<device_driver::vulkan_native>> tokens, usize time_out
+        ) -> std::expected<usize, device_error> {
+            if (tokens.empty()){
+                return std::unexpected{device_error::not_available};
+            }
+
+            retire_launches();
+            for (usize i = 0; i < tokens.size(); ++i){
+                if (find_in_flight(tokens[i]) == in_flight.end()) return i;
+            }
+
+            auto fences = in_flight_fences(tokens);
+            if (vkWaitForFences(device_handle, static_cast<u32>(fences.size()), fences.data(), VK_FALSE, time_out) != VK_SUCCESS){
+                return std::unexpected{device_error::kernel_timout_reached};
+            }
+
+            retire_launches();
+            for (usize i = 0; i < tokens.size(); ++i){
+                if (find_in_flight(tokens[i]) == in_flight.end()) return i;
+            }
+            return std::unexpected{device_error::unexpected_crash};
+        }
+
+        // Starts recording: launches are appended to one command buffer, with pipeline barriers derived from the
+        // buffers each dispatch reads and writes, until submit_sequence() submits them all at once. Launches
+        // without declared access treat every bound buffer as read_write. Host-side waits and downloads of
+        // buffers used by the sequence have to wait for its token.
+        auto begin_sequence() -> std::expected<void, device_error> {
+            return begin_recording(false);
+        }
+
+        // Ends the recording and submits it with one vkQueueSubmit, the token completes with the last dispatch
+        auto submit_sequence() -> std::expected<launch_token<device_driver::vulkan_native>, device_error> {
+            if (!sequence.active || sequence.capture){
+                return std::unexpected{device_error::launch_failed};
+            }
+
+            if (vkEndCommandBuffer(sequence.command_buffer) != VK_SUCCESS){
+                cancel_sequence();
+                return std::unexpected{device_error::could_not_dispatch_kernel_to_command_buffer};
+            }
+
+            auto token = submit_recorded(sequence.command_buffer, sequence.buffers, sequence.wait_transfer, sequence.pipelines, false);
+            if (!token.has_value()){
+                cancel_sequence();
+                return std::unexpected{token.error()};
+            }
+
+            last_sequence_stats = sequence.stats;
+            sequence = sequence_state{};
+            return token;
+        }
+
+        // Drops the recording (sequence or capture) without submitting anything
+        auto cancel_sequence() -> void {
+            if (!sequence.active) return;
+
+            vkResetCommandBuffer(sequence.command_buffer, 0);
+            free_command_buffers.push_back(sequence.command_buffer);
+            sequence = sequence_state{};
+        }
+
+        auto recording() const -> bool { return sequence.active; }
+
+        // Dispatch and barrier count of the last submitted sequence or captured graph
+        auto sequence_statistics() const -> sequence_stats { return last_sequence_stats; }
+
+        // Like begin_sequence(), but end_capture() keeps the recorded command buffer with its bindings and
+        // push constants as a graph that replay() submits again with a single vkQueueSubmit. The graph is
+        // bound to the buffers it was captured with; their contents may change between replays (mapped
+        // buffers, uploads), which is also how per-replay parameters reach kernels that read them from a
+        // small host-visible buffer instead of push constants.
+        auto begin_capture() -> std::expected<void, device_error> {
+            return begin_recording(true);
+        }
+
+        auto end_capture() -> std::expected<command_graph<device_driver::vulkan_native>, device_error> {
+            if (!sequence.active || !sequence.capture){
+                return std::unexpected{device_error::launch_failed};
+            }
+
+            if (vkEndCommandBuffer(sequence.command_buffer) != VK_SUCCESS){
+                cancel_sequence();
+                return std::unexpected{device_error::could_not_dispatch_kernel_to_command_buffer};
+            }
+
+            const command_graph<device_driver::vulkan_native> graph{ ++graph_serial };
+            graphs.emplace(graph.id, captured_graph{
+                sequence.command_buffer, std::move(sequence.pipelines), std::move(sequence.buffers), {}
+            });
+            last_sequence_stats = sequence.stats;
+            sequence = sequence_state{};
+            return graph;
+        }
+
+        // Submits a captured graph. Descriptor sets and commands are reused as recorded, only the waits on
+        // pending async uploads into its buffers are recomputed. A replay still running is waited for first.
+        auto replay(
+            const command_graph<device_driver::vulkan_native>& graph
+        ) -> std::expected<launch_token<device_driver::vulkan_native>, device_error> {
+            auto it = graphs.find(graph.id);
+            if (it == graphs.end() || sequence.active){
+                return std::unexpected{device_error::launch_failed};
+            }
+            auto& captured = it->second;
+
+            if (auto pending = find_in_flight(captured.last_replay); pending != in_flight.end()){
+                if (vkWaitForFences(device_handle, 1, &pending->fence, VK_TRUE, std::numeric_limits<u64>::max()) != VK_SUCCESS){
+                    return std::unexpected{device_error::kernel_timout_reached};
+                }
+            }
+            retire_launches();
+
+            u64 wait_transfer = 0;
+            for (VkBuffer buff : captured.buffers){
+                if (auto sync = buffer_syncs.find(buff); sync != buffer_syncs.end()){
+                    wait_transfer = std::max(wait_transfer, sync->second.transfer_value);
+                }
+            }
+
+            auto token = submit_recorded(captured.command_buffer, captured.buffers, wait_transfer, captured.pipelines, true);
+            if (!token.has_value()) return std::unexpected{token.error()};
+
+            captured.last_replay = token.value();
+            return token;
+        }
+
+        // Waits for the graph's last replay and releases its command buffer
+        auto destroy_graph(command_graph<device_driver::vulkan_native>& graph) -> void {
+            auto it = graphs.find(graph.id);
+            if (it == graphs.end()) return;
+
+            if (auto pending = find_in_flight(it->second.last_replay); pending != in_flight.end()){
+                vkWaitForFences(device_handle, 1, &pending->fence, VK_TRUE, std::numeric_limits<u64>::max());
+            }
+            retire_launches();
+
+            vkResetCommandBuffer(it->second.command_buffer, 0);
+            free_command_buffers.push_back(it->second.command_buffer);
+            graphs.erase(it);
+            graph.id = 0;
+        }
+
+        // Waits for the kernel's sync launch and all of its async launches in flight
         auto wait_for_kernel(
             kernel<device_driver::vulkan_native>& task, usize time_out
         ) -> std::expected<void, device_error> {
-            if(vkWaitForFences(device_handle, 1, &task.lock, VK_TRUE, time_out) != VK_SUCCESS){
+            // The fence belongs to the registered kernel and is reused by its next launch
+            std::vector<VkFence> fences;
+            if (task.lock != VK_NULL_HANDLE) fences.push_back(task.lock);
+            for (const auto& launch : in_flight){
+                if (launch.uses(task.pipeline)) fences.push_back(launch.fence);
+            }
+
+            if(!fences.empty() && vkWaitForFences(device_handle, static_cast<u32>(fences.size()), fences.data(), VK_TRUE, time_out) != VK_SUCCESS){
                 return std::unexpected{device_error::kernel_timout_reached};
             }
-            
-            vkDestroyFence(device_handle, task.lock, nullptr);
-            task.lock = VK_NULL_HANDLE;
 
+            retire_launches();
             return {};
         }
 
         auto wait_for_last_kernel(
             usize time_out
         ) -> std::expected<void, device_error> {
+            if (last_launch.serial != 0){
+                return wait_for_launch(last_launch, time_out);
+            }
+
             if(vkWaitForFences(device_handle, 1, &last_kernel.lock, VK_TRUE, time_out) != VK_SUCCESS){
                 return std::unexpected{device_error::kernel_timout_reached};
             }
-            
-            vkDestroyFence(device_handle, last_kernel.lock, nullptr);
-            last_kernel.lock = VK_NULL_HANDLE;
 
             return {};
         }
 
+        // Destroys a kernel and drops it from the registry, the next register_kernel builds it again.
+        // Registered kernels are released by exit(), calling this is only needed to evict one early.
         auto destroy_kernel(kernel<device_driver::vulkan_native>& task) -> void {
+            if (task.pipeline != VK_NULL_HANDLE){
+                std::erase_if(kernel_registry, [&](const auto& entry){ return entry.second.pipeline == task.pipeline; });
+                if (last_kernel.pipeline == task.pipeline) last_kernel = {};
+                destroy_launch_slots(task.pipeline);
+                destroy_descriptor_cache(task.pipeline);
+            }
+
             if (task.lock != VK_NULL_HANDLE){
+                vkWaitForFences(device_handle, 1, &task.lock, VK_TRUE, std::numeric_limits<u64>::max());
                 vkDestroyFence(device_handle, task.lock, nullptr);
                 task.lock = VK_NULL_HANDLE;
             }
 
-            if (task.descriptor_pool != VK_NULL_HANDLE){
-                vkDestroyDescriptorPool(device_handle, task.descriptor_pool, nullptr);
-                task.descriptor_pool = VK_NULL_HANDLE;
-            }
-
             if (task.pipeline != VK_NULL_HANDLE){
                 vkDestroyPipeline(device_handle, task.pipeline, nullptr);
                 task.pipeline = VK_NULL_HANDLE;
@@ -303,12 +823,78 @@ namespace tether_io{
         }
 
         void exit(){
-            vkDeviceWaitIdle(device_handle);
+            if (device_handle != VK_NULL_HANDLE){
+                vkDeviceWaitIdle(device_handle);
+            }
+
+            cancel_sequence();
+            graphs.clear(); // command buffers are freed with the command pool, slots below
+
+            auto registered = std::move(kernel_registry);
+            kernel_registry.clear();
+            for (auto& [key, krnl] : registered){
+                destroy_kernel(krnl);
+            }
+            last_kernel = {};
+            last_launch = {};
+
+            launch_slots.clear(); // command buffers are freed with the command pool
+            for (auto& [pipeline, cache] : descriptor_caches){
+                for (const auto& slot : cache.pools) vkDestroyDescriptorPool(device_handle, slot.pool, nullptr);
+            }
+            descriptor_caches.clear();
+            push_descriptors = false;
+            cmd_push_descriptor_set = nullptr;
+            for (const auto& launch : in_flight) free_fences.push_back(launch.fence);
+            in_flight.clear();
+            for (VkFence fence : free_fences) vkDestroyFence(device_handle, fence, nullptr);
+            free_fences.clear();
+            free_command_buffers.clear(); // freed with the command pool
+
+            save_pipeline_cache();
+            if (pipeline_cache != VK_NULL_HANDLE){
+                vkDestroyPipelineCache(device_handle, pipeline_cache, nullptr);
+                pipeline_cache = VK_NULL_HANDLE;
+            }
             
             for(auto& buff: buffer_states){
-                vkDestroyBuffer(device_handle, buff.buff_handle, nullptr); 
-                vkFreeMemory(device_handle, buff.memory_handle, nullptr);
+                release_buffer(buff);
+            }
+            buffer_states.clear();
+
+            for(auto& block: pool_blocks){
+                if (block.memory != VK_NULL_HANDLE) vkFreeMemory(device_handle, block.memory, nullptr);
+            }
+            pool_blocks.clear();
+
+            destroy_buffer(staging_buffer);
+
+            for (auto& slot : staging_slots){
+                destroy_buffer(slot.buff);
+            }
+            staging_slots.clear();
+            pending_downloads.clear();
+            buffer_syncs.clear();
+
+            for (VkSemaphore* timeline : { &transfer_timeline, &compute_timeline }){
+                if (*timeline != VK_NULL_HANDLE){
+                    vkDestroySemaphore(device_handle, *timeline, nullptr);
+                    *timeline = VK_NULL_HANDLE;
+                }
             }
+            transfer_value = 0;
+            compute_value = 0;
+
+            if (transfer_command_pool != VK_NULL_HANDLE){
+                vkDestroyCommandPool(device_handle, transfer_command_pool, nullptr);
+                transfer_command_pool = VK_NULL_HANDLE;
+            }
+
+            if (transfer_lock != VK_NULL_HANDLE){
+                vkDestroyFence(device_handle, transfer_lock, nullptr);
+                transfer_lock = VK_NULL_HANDLE;
+            }
+            transfer_command_buffer = VK_NULL_HANDLE; // freed with the command pool
             
             if (command_pool != VK_NULL_HANDLE){
                 vkDestroyCommandPool(device_handle, command_pool, nullptr);
@@ -337,63 +923,594 @@ namespace tether_io{
         VkPhysicalDevice device{};
         VkDevice device_handle{};
 
-        // Queues
+        // Queues. Async transfers use a transfer-only family when the device has one, otherwise a second
+        // queue of the compute family (or the compute queue itself).
         u32 queue_family = 0;
         VkQueue queue_handle{};
+        u32 transfer_family = 0;
+        u32 transfer_queue_index = 0;
+        VkQueue transfer_queue{};
+        std::array<u32, 2> queue_family_indices{};
 
-        // Command pool
+        // Command pools
         VkCommandPool command_pool{};
+        VkCommandPool transfer_command_pool{};
+
+        // Timeline semaphores ordering the two queues. Each submission signals the next value of its queue's
+        // timeline, buffer_syncs remembers per buffer the last values that touched it.
+        bool timeline_semaphores = false;
+        bool buffer_device_address = false; // storage buffers get a VkDeviceAddress
+        VkSemaphore transfer_timeline{};
+        VkSemaphore compute_timeline{};
+        u64 transfer_value = 0;
+        u64 compute_value = 0;
+
+        struct buffer_sync {
+            u64 transfer_value{}; // last async upload into the buffer
+            u64 compute_value{};  // last dispatch or compute-queue copy that used it
+        };
+        std::unordered_map<VkBuffer, buffer_sync> buffer_syncs;
+
+        // Staging memory of in-flight async transfers, a slot is reused once the timeline passes release_value
+        struct staging_slot {
+            device_buffer<device_driver::vulkan_native> buff;
+            VkCommandBuffer command_buffer{};
+            u64 release_value{};
+        };
+        std::vector<staging_slot> staging_slots;
+
+        // Async downloads whose host copy runs once the transfer timeline reaches value
+        struct pending_download {
+            u64 value;
+            const void* src;
+            void* dest;
+            usize size_bytes;
+        };
+        std::vector<pending_download> pending_downloads;
+
+        // Integrated / CPU device: device-local memory is also host visible, staging copies are skipped
+        bool unified_memory = false;
+
+        // Staging for device-local buffers, grown to the largest transfer and reused
+        device_buffer<device_driver::vulkan_native> staging_buffer;
+        VkCommandBuffer transfer_command_buffer{};
+        VkFence transfer_lock{};
 
         // Keep a list of all allocated buffer to be able to destory in the future on exit. 
         std::vector<device_buffer<device_driver::vulkan_native>> buffer_states;
 
-        // Last kernel launched
+        // Memory pool for alloc_method::custom: large blocks per memory type, split by a buddy allocator
+        struct pool_block {
+            VkDeviceMemory memory{};
+            void* mapped{};
+            u32 memory_type{};
+            buddy_allocator allocator;
+        };
+        static constexpr usize pool_block_bytes = usize(64) << 20;
+        static constexpr usize pool_min_allocation = 256;
+        std::vector<pool_block> pool_blocks;
+
+        // Last kernel launched, last_launch is set while the latest launch was async
         kernel<device_driver::vulkan_native> last_kernel;
+        launch_token<device_driver::vulkan_native> last_launch;
 
-        auto is_valid_workgroup_size(vec3<u32> work_group_size) -> bool {
-            if (work_group_size.x == 0 || work_group_size.y == 0 || work_group_size.z == 0){
-                return false;
+        // Per-launch objects of async launches, recycled per pipeline once the launch has retired
+        struct launch_slot {
+            VkCommandBuffer command_buffer{};
+            bool busy{};
+        };
+        std::unordered_map<VkPipeline, std::vector<launch_slot>> launch_slots;
+
+        // An async launch holds a slot of its pipeline, a submitted sequence its own command buffer (returned on
+        // retirement), a graph replay neither
+        struct in_flight_launch {
+            u64 serial;
+            VkFence fence;
+            std::vector<VkPipeline> pipelines;
+            usize slot; // no_slot unless a single async launch
+            VkCommandBuffer command_buffer;
+
+            auto uses(VkPipeline pipeline) const -> bool {
+                return std::find(pipelines.begin(), pipelines.end(), pipeline) != pipelines.end();
             }
-
-            constexpr auto workgroup_size_max = std::numeric_limits<u32>::max();
-            if (work_group_size.x > workgroup_size_max || work_group_size.y > workgroup_size_max || work_group_size.z > workgroup_size_max){
-                return false;
+        };
+        static constexpr usize no_slot = std::numeric_limits<usize>::max();
+        std::vector<in_flight_launch> in_flight;
+        std::vector<VkFence> free_fences; // unsignaled, ready for the next submission
+        std::vector<VkCommandBuffer> free_command_buffers; // sequence command buffers of retired submissions
+        u64 launch_serial = 0;
+
+        // Recording state between begin_sequence() and submit_sequence(). hazards holds per buffer what the
+        // recorded dispatches did to it since the last barrier that covered it.
+        struct sequence_state {
+            bool active{};
+            bool capture{}; // begin_capture(): kept as a graph instead of submitted
+            VkCommandBuffer command_buffer{};
+            std::vector<VkPipeline> pipelines;
+            std::unordered_map<VkBuffer, u8> hazards; // bit 0: read, bit 1: written
+            std::vector<VkBuffer> buffers;
+            u64 wait_transfer{};
+            sequence_stats stats{};
+        };
+        sequence_state sequence;
+        sequence_stats last_sequence_stats{};
+
+        // Graphs kept by end_capture() until destroy_graph()
+        struct captured_graph {
+            VkCommandBuffer command_buffer;
+            std::vector<VkPipeline> pipelines;
+            std::vector<VkBuffer> buffers;
+            launch_token<device_driver::vulkan_native> last_replay;
+
+            auto uses(VkPipeline pipeline) const -> bool {
+                return std::find(pipelines.begin(), pipelines.end(), pipeline) != pipelines.end();
             }
-            return true;
         };
+        std::unordered_map<u64, captured_graph> graphs;
+        u64 graph_serial = 0;
+
+        // Descriptor sets per pipeline and bound buffers (handle and range), written once and bound by every
+        // later launch with the same buffers. Sets are never updated after they were written, so one set can
+        // be bound by any number of launches in flight. Unused with VK_KHR_push_descriptor.
+        struct descriptor_cache {
+            using key = std::vector<std::pair<VkBuffer, usize>>;
+            struct pool_slot {
+                VkDescriptorPool pool{};
+                u32 free{}; // of descriptor_pool_sets, a pool with none in use is destroyed
+            };
+            std::map<key, std::pair<VkDescriptorSet, VkDescriptorPool>> sets;
+            std::vector<pool_slot> pools;
+        };
+        static constexpr u32 descriptor_pool_sets = 64;
+        std::unordered_map<VkPipeline, descriptor_cache> descriptor_caches;
+
+        // VK_KHR_push_descriptor: bindings are written into the command buffer, no sets are allocated
+        bool push_descriptors{};
+        PFN_vkCmdPushDescriptorSetKHR cmd_push_descriptor_set{};
+
+        // Registered kernels by kernel_registry_key and the pipeline cache they are built through. The cache is
+        // read from and written back to <kernel binary dir>/pipeline_cache.bin so later runs start warm.
+        std::unordered_map<str, kernel<device_driver::vulkan_native>> kernel_registry;
+        VkPipelineCache pipeline_cache{};
+        std::filesystem::path pipeline_cache_path;
+
+        auto acquire_fence() -> std::expected<VkFence, device_error> {
+            if (!free_fences.empty()){
+                VkFence fence = free_fences.back();
+                free_fences.pop_back();
+                return fence;
+            }
 
-        auto find_first_computable_deivce() -> bool {
-            //std::cout << "devices.size() = " << devices.size() << std::endl;
-            for (auto dev : devices){
-                // Get list of all available queues of device
-                u32 queue_family_count=0; 
-                vkGetPhysicalDeviceQueueFamilyProperties(dev, &queue_family_count, nullptr);
-                
-                //std::cout << "queue_family_count = " << queue_family_count << std::endl;
+            VkFence fence{};
+            VkFenceCreateInfo fci{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+            if (vkCreateFence(device_handle, &fci, nullptr, &fence) != VK_SUCCESS){
+                return std::unexpected{device_error::launch_failed};
+            }
+            return fence;
+        }
 
-                // Get properties of these queues.
-                std::vector<VkQueueFamilyProperties> queue_family_props(queue_family_count); 
-                vkGetPhysicalDeviceQueueFamilyProperties(dev, &queue_family_count, queue_family_props.data());
-                
-                // Loop through all properties and look if the compute flag is set
-                for(u32 i = 0; i < queue_family_count; ++i){
-                    //std::cout << "queue_family_props[" << i << "].queueFlags = " << queue_family_props[i].queueFlags << std::endl;
-                    if(queue_family_props[i].queueFlags & VK_QUEUE_COMPUTE_BIT){
-                        //std::cout << "queue_family_props[i].queueFlags & VK_QUEUE_COMPUTE_BIT" << std::endl;
-                        device = dev;
-                        queue_family = i;
-                        break;
-                    }
-                }
-                
-                if (device){
-                    //std::cout << "if (device)" << std::endl;
-                    return true;
-                };
+        // Free slot of the kernel, a new one when all are in flight
+        auto acquire_launch_slot(
+            const kernel<device_driver::vulkan_native>& task
+        ) -> std::expected<usize, device_error> {
+            auto& slots = launch_slots[task.pipeline];
+            for (usize i = 0; i < slots.size(); ++i){
+                if (!slots[i].busy) return i;
+            }
+
+            launch_slot slot{};
+
+            VkCommandBufferAllocateInfo cbai{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+            cbai.commandPool = command_pool;
+            cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            cbai.commandBufferCount = 1;
+            if (vkAllocateCommandBuffers(device_handle, &cbai, &slot.command_buffer) != VK_SUCCESS){
+                return std::unexpected{device_error::launch_failed};
+            }
+
+            slots.push_back(slot);
+            return slots.size() - 1;
+        }
+
+        // Retires finished async launches: fences go back to the pool (reset), slots become free
+        auto retire_launches() -> void {
+            std::erase_if(in_flight, [&](const in_flight_launch& launch){
+                if (vkGetFenceStatus(device_handle, launch.fence) != VK_SUCCESS) return false;
+
+                vkResetFences(device_handle, 1, &launch.fence);
+                free_fences.push_back(launch.fence);
+                if (launch.slot != no_slot){
+                    if (auto it = launch_slots.find(launch.pipelines.front()); it != launch_slots.end() && launch.slot < it->second.size()){
+                        it->second[launch.slot].busy = false;
+                    }
+                }
+                if (launch.command_buffer != VK_NULL_HANDLE) free_command_buffers.push_back(launch.command_buffer);
+                return true;
+            });
+        }
+
+        auto find_in_flight(const launch_token<device_driver::vulkan_native>& token) -> std::vector<in_flight_launch>::iterator {
+            return std::find_if(in_flight.begin(), in_flight.end(), [&](const auto& launch){ return launch.serial == token.serial; });
+        }
+
+        auto in_flight_fences(std::span<const launch_token<device_driver::vulkan_native>> tokens) -> std::vector<VkFence> {
+            std::vector<VkFence> fences;
+            for (const auto& token : tokens){
+                if (auto it = find_in_flight(token); it != in_flight.end()) fences.push_back(it->fence);
+            }
+            return fences;
+        }
+
+        auto destroy_launch_slots(VkPipeline pipeline) -> void {
+            std::vector<VkFence> fences;
+            for (const auto& launch : in_flight){
+                if (launch.uses(pipeline)) fences.push_back(launch.fence);
+            }
+            if (!fences.empty()){
+                vkWaitForFences(device_handle, static_cast<u32>(fences.size()), fences.data(), VK_TRUE, std::numeric_limits<u64>::max());
+            }
+            retire_launches();
+
+            // Graphs recorded with the kernel would replay destroyed descriptor sets
+            std::erase_if(graphs, [&](auto& entry){
+                if (!entry.second.uses(pipeline)) return false;
+                vkResetCommandBuffer(entry.second.command_buffer, 0);
+                free_command_buffers.push_back(entry.second.command_buffer);
+                return true;
+            });
+
+            if (auto it = launch_slots.find(pipeline); it != launch_slots.end()){
+                for (auto& slot : it->second){
+                    vkFreeCommandBuffers(device_handle, command_pool, 1, &slot.command_buffer);
+                }
+                launch_slots.erase(it);
+            }
+        }
+
+        // Binds buffers, records and submits one dispatch of task (whose objects may belong to a launch slot),
+        // ordered after pending async uploads into the bound buffers
+        template<class_type KernelParams>
+        auto submit_launch(
+            kernel<device_driver::vulkan_native>& task,
+            vec3<u32> workgroup_size,
+            std::initializer_list<device_buffer<device_driver::vulkan_native>> buffers,
+            KernelParams kernel_params
+        ) -> std::expected<void, device_error> {
+            if(!bind_descriptor_set(task, buffers)){
+                return std::unexpected{device_error::could_not_update_descriptors}; 
+            }
+
+            // Wait on the GPU for async uploads into any bound buffer
+            u64 wait_transfer = 0;
+            for (const auto& buff : buffers){
+                if (auto it = buffer_syncs.find(buff.buff_handle); it != buffer_syncs.end()){
+                    wait_transfer = std::max(wait_transfer, it->second.transfer_value);
+                }
+            }
+
+            if(!dispatch_kernel_to_command_buffer(task, workgroup_size, buffers, kernel_params, wait_transfer)){
+                return std::unexpected{device_error::could_not_dispatch_kernel_to_command_buffer}; 
+            }
+
+            if (timeline_semaphores){
+                for (const auto& buff : buffers) buffer_syncs[buff.buff_handle].compute_value = compute_value;
+            }
+            return {};
+        }
+
+        auto begin_recording(bool capture) -> std::expected<void, device_error> {
+            if (sequence.active || device_handle == VK_NULL_HANDLE){
+                return std::unexpected{device_error::launch_failed};
+            }
+
+            retire_launches();
+
+            VkCommandBuffer command_buffer{};
+            if (!free_command_buffers.empty()){
+                command_buffer = free_command_buffers.back();
+                free_command_buffers.pop_back();
+            } else {
+                VkCommandBufferAllocateInfo cbai{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+                cbai.commandPool = command_pool;
+                cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                cbai.commandBufferCount = 1;
+                if (vkAllocateCommandBuffers(device_handle, &cbai, &command_buffer) != VK_SUCCESS){
+                    return std::unexpected{device_error::launch_failed};
+                }
+            }
+
+            vkResetCommandBuffer(command_buffer, 0);
+            VkCommandBufferBeginInfo cbbi{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+            cbbi.flags = capture ? 0 : VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            if (vkBeginCommandBuffer(command_buffer, &cbbi) != VK_SUCCESS){
+                free_command_buffers.push_back(command_buffer);
+                return std::unexpected{device_error::launch_failed};
+            }
+
+            // A graph is replayed after arbitrary other work on the queue, its first dispatches are ordered after
+            // every earlier shader write
+            if (capture){
+                VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+                barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+                vkCmdPipelineBarrier(
+                    command_buffer,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    0, 1, &barrier, 0, nullptr, 0, nullptr
+                );
+            }
+
+            sequence = sequence_state{};
+            sequence.active = true;
+            sequence.capture = capture;
+            sequence.command_buffer = command_buffer;
+            return {};
+        }
+
+        // Submits a recorded command buffer with a pooled fence on the compute timeline. Graph replays keep
+        // their command buffer when they retire, sequences hand it back.
+        auto submit_recorded(
+            VkCommandBuffer command_buffer,
+            const std::vector<VkBuffer>& buffers,
+            u64 wait_transfer,
+            std::vector<VkPipeline>& pipelines,
+            bool replay
+        ) -> std::expected<launch_token<device_driver::vulkan_native>, device_error> {
+            auto fence = acquire_fence();
+            if (!fence.has_value()) return std::unexpected{fence.error()};
+
+            if (!submit_with_timelines(
+                queue_handle, std::span<const VkCommandBuffer>(&command_buffer, 1),
+                transfer_timeline, wait_transfer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                compute_timeline, compute_value + 1,
+                fence.value()
+            )){
+                free_fences.push_back(fence.value());
+                return std::unexpected{device_error::could_not_dispatch_kernel_to_command_buffer};
+            }
+
+            if (timeline_semaphores){
+                ++compute_value;
+                for (VkBuffer buff : buffers) buffer_syncs[buff].compute_value = compute_value;
+            }
+
+            const launch_token<device_driver::vulkan_native> token{ ++launch_serial };
+            if (replay){
+                in_flight.push_back(in_flight_launch{ token.serial, fence.value(), pipelines, no_slot, VK_NULL_HANDLE });
+            } else {
+                in_flight.push_back(in_flight_launch{ token.serial, fence.value(), std::move(pipelines), no_slot, command_buffer });
+            }
+            last_launch = token;
+            return token;
+        }
+
+        // Appends one dispatch to the active sequence. A buffer the dispatch reads after an earlier one wrote it
+        // (RAW), or writes after an earlier one read or wrote it (WAR, WAW), gets a buffer barrier first; all
+        // barriers in front of a dispatch go into one vkCmdPipelineBarrier.
+        template<class_type KernelParams>
+        auto record_launch(
+            kernel<device_driver::vulkan_native>& task,
+            vec3<u32> workgroup_size,
+            std::initializer_list<device_buffer<device_driver::vulkan_native>> buffers,
+            KernelParams kernel_params,
+            std::span<const buffer_access> access
+        ) -> std::expected<void, device_error> {
+            if (task.pipeline == VK_NULL_HANDLE || (!access.empty() && access.size() != buffers.size())){
+                return std::unexpected{device_error::launch_failed};
+            }
+
+            kernel<device_driver::vulkan_native> slot_task = task;
+            slot_task.command_buffer = sequence.command_buffer;
+            if (!bind_descriptor_set(slot_task, buffers)){
+                return std::unexpected{device_error::could_not_update_descriptors};
+            }
+            if (std::find(sequence.pipelines.begin(), sequence.pipelines.end(), task.pipeline) == sequence.pipelines.end()){
+                sequence.pipelines.push_back(task.pipeline);
+            }
+
+            constexpr u8 read_bit = 1, write_bit = 2;
+            auto mode_of = [&](usize i) -> u8 {
+                if (access.empty()) return read_bit | write_bit;
+                switch (access[i]){
+                    case buffer_access::read:  return read_bit;
+                    case buffer_access::write: return write_bit;
+                    default:                   return read_bit | write_bit;
+                }
+            };
+
+            std::vector<VkBufferMemoryBarrier> barriers;
+            usize i = 0;
+            for (const auto& buff : buffers){
+                const u8 mode = mode_of(i++);
+                const u8 state = sequence.hazards[buff.buff_handle];
+                const bool hazard = ((mode & read_bit) && (state & write_bit)) || ((mode & write_bit) && state != 0);
+                if (!hazard) continue;
+
+                VkBufferMemoryBarrier barrier{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+                barrier.srcAccessMask = (state & write_bit) ? VK_ACCESS_SHADER_WRITE_BIT : 0;
+                barrier.dstAccessMask = ((mode & read_bit) ? VK_ACCESS_SHADER_READ_BIT : 0) | ((mode & write_bit) ? VK_ACCESS_SHADER_WRITE_BIT : 0);
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.buffer = buff.buff_handle;
+                barrier.offset = 0;
+                barrier.size = VK_WHOLE_SIZE;
+                if (std::none_of(barriers.begin(), barriers.end(), [&](const auto& b){ return b.buffer == barrier.buffer; })){
+                    barriers.push_back(barrier);
+                }
+            }
+
+            if (!barriers.empty()){
+                vkCmdPipelineBarrier(
+                    sequence.command_buffer,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    0, 0, nullptr, static_cast<u32>(barriers.size()), barriers.data(), 0, nullptr
+                );
+                sequence.stats.barriers += 1;
+
+                // The execution dependency orders every earlier read, the covered writes are now visible
+                for (auto& [buffer, state] : sequence.hazards) state &= ~read_bit;
+                for (const auto& barrier : barriers) sequence.hazards[barrier.buffer] = 0;
+            }
+
+            i = 0;
+            for (const auto& buff : buffers){
+                sequence.hazards[buff.buff_handle] |= mode_of(i++);
+                if (auto it = buffer_syncs.find(buff.buff_handle); it != buffer_syncs.end()){
+                    sequence.wait_transfer = std::max(sequence.wait_transfer, it->second.transfer_value);
+                }
+                if (std::find(sequence.buffers.begin(), sequence.buffers.end(), buff.buff_handle) == sequence.buffers.end()){
+                    sequence.buffers.push_back(buff.buff_handle);
+                }
+            }
+
+            record_dispatch(sequence.command_buffer, slot_task, workgroup_size, buffers, kernel_params);
+            sequence.stats.dispatches += 1;
+            return {};
+        }
+
+        static auto kernel_registry_key(
+            const str& name, vec3<u32> workgroup_size, std::span<const u32> specialization, usize binding_count
+        ) -> str {
+            str key = name;
+            key += '|' + std::to_string(workgroup_size.x) + ',' + std::to_string(workgroup_size.y) + ',' + std::to_string(workgroup_size.z);
+            key += '|';
+            for (u32 value : specialization) key += std::to_string(value) + ',';
+            key += '|' + std::to_string(binding_count);
+            return key;
+        }
+
+        // Creates the pipeline cache on first use, seeded from disk when the stored header matches this device
+        auto open_pipeline_cache(const std::filesystem::path& dir) -> void {
+            if (pipeline_cache != VK_NULL_HANDLE) return;
+
+            pipeline_cache_path = dir / "pipeline_cache.bin";
+
+            std::vector<char> initial;
+            std::ifstream cache_file(pipeline_cache_path, std::ios::binary);
+            if (cache_file){
+                initial.assign(std::istreambuf_iterator<char>(cache_file), std::istreambuf_iterator<char>());
+            }
+
+            // Header: length, version, vendorID, deviceID, pipelineCacheUUID
+            VkPhysicalDeviceProperties props{};
+            vkGetPhysicalDeviceProperties(device, &props);
+            constexpr usize header_bytes = 16 + VK_UUID_SIZE;
+            if (initial.size() >= header_bytes){
+                u32 header[4];
+                std::memcpy(header, initial.data(), sizeof(header));
+                const bool matches = header[2] == props.vendorID && header[3] == props.deviceID &&
+                    std::memcmp(initial.data() + 16, props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+                if (!matches) initial.clear();
+            } else {
+                initial.clear();
+            }
+
+            VkPipelineCacheCreateInfo pcci{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+            pcci.initialDataSize = initial.size();
+            pcci.pInitialData = initial.empty() ? nullptr : initial.data();
+            if (vkCreatePipelineCache(device_handle, &pcci, nullptr, &pipeline_cache) != VK_SUCCESS){
+                // A rejected blob is not fatal, start from an empty cache
+                pcci.initialDataSize = 0;
+                pcci.pInitialData = nullptr;
+                if (vkCreatePipelineCache(device_handle, &pcci, nullptr, &pipeline_cache) != VK_SUCCESS){
+                    pipeline_cache = VK_NULL_HANDLE;
+                }
+            }
+        }
+
+        auto save_pipeline_cache() -> void {
+            if (pipeline_cache == VK_NULL_HANDLE || pipeline_cache_path.empty()) return;
+
+            usize size = 0;
+            if (vkGetPipelineCacheData(device_handle, pipeline_cache, &size, nullptr) != VK_SUCCESS || size == 0) return;
+
+            std::vector<char> data(size);
+            if (vkGetPipelineCacheData(device_handle, pipeline_cache, &size, data.data()) != VK_SUCCESS) return;
+
+            // Write next to the target and rename, a crash mid-write must not leave a truncated cache behind
+            std::filesystem::path tmp_path = pipeline_cache_path;
+            tmp_path += ".tmp";
+            {
+                std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+                if (!out) return;
+                out.write(data.data(), static_cast<std::streamsize>(size));
+                if (!out) return;
+            }
+            std::error_code ec;
+            std::filesystem::rename(tmp_path, pipeline_cache_path, ec);
+        }
+
+        auto is_valid_workgroup_size(vec3<u32> work_group_size) -> bool {
+            if (work_group_size.x == 0 || work_group_size.y == 0 || work_group_size.z == 0){
+                return false;
+            }
+
+            constexpr auto workgroup_size_max = std::numeric_limits<u32>::max();
+            if (work_group_size.x > workgroup_size_max || work_group_size.y > workgroup_size_max || work_group_size.z > workgroup_size_max){
+                return false;
+            }
+            return true;
+        };
+
+        auto find_first_computable_deivce() -> bool {
+            //std::cout << "devices.size() = " << devices.size() << std::endl;
+            for (auto dev : devices){
+                // Get list of all available queues of device
+                u32 queue_family_count=0; 
+                vkGetPhysicalDeviceQueueFamilyProperties(dev, &queue_family_count, nullptr);
+                
+                //std::cout << "queue_family_count = " << queue_family_count << std::endl;
+
+                // Get properties of these queues.
+                std::vector<VkQueueFamilyProperties> queue_family_props(queue_family_count); 
+                vkGetPhysicalDeviceQueueFamilyProperties(dev, &queue_family_count, queue_family_props.data());
+                
+                // Loop through all properties and look if the compute flag is set
+                for(u32 i = 0; i < queue_family_count; ++i){
+                    //std::cout << "queue_family_props[" << i << "].queueFlags = " << queue_family_props[i].queueFlags << std::endl;
+                    if(queue_family_props[i].queueFlags & VK_QUEUE_COMPUTE_BIT){
+                        //std::cout << "queue_family_props[i].queueFlags & VK_QUEUE_COMPUTE_BIT" << std::endl;
+                        device = dev;
+                        queue_family = i;
+                        break;
+                    }
+                }
+                
+                if (device){
+                    //std::cout << "if (device)" << std::endl;
+                    select_transfer_family(queue_family_props);
+                    return true;
+                };
             }
             return false;
         };
 
+        // Prefers a transfer-only family (the DMA engines of discrete GPUs), then a second queue of the compute family
+        auto select_transfer_family(const std::vector<VkQueueFamilyProperties>& families) -> void {
+            transfer_family = queue_family;
+            transfer_queue_index = families[queue_family].queueCount > 1 ? 1 : 0;
+
+            for (u32 i = 0; i < families.size(); ++i){
+                const auto flags = families[i].queueFlags;
+                if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_COMPUTE_BIT | VK_QUEUE_GRAPHICS_BIT))){
+                    transfer_family = i;
+                    transfer_queue_index = 0;
+                    return;
+                }
+            }
+        }
+
+        // Buffers are shared by both queue families without ownership transfers
+        auto set_sharing_mode(VkBufferCreateInfo& buffer_cfg) -> void {
+            if (transfer_family == queue_family){
+                buffer_cfg.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                return;
+            }
+            buffer_cfg.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            buffer_cfg.queueFamilyIndexCount = static_cast<u32>(queue_family_indices.size());
+            buffer_cfg.pQueueFamilyIndices = queue_family_indices.data();
+        }
+
         auto find_memory_type_index(u32 type_bits, VkMemoryPropertyFlags req) -> std::expected<u32, device_error> {
              VkPhysicalDeviceMemoryProperties mp{}; 
              vkGetPhysicalDeviceMemoryProperties(device, &mp);
@@ -409,18 +1526,68 @@ namespace tether_io{
 
         auto create_device() -> bool { 
 
-            f32 queue_priority = 1.0f;
+            std::array<f32, 2> queue_priorities{ 1.0f, 1.0f };
+
+            // Configure queue settings, the compute queue and the transfer queue (own family or second queue)
+            std::array<VkDeviceQueueCreateInfo, 2> queue_cfgs{};
+            u32 queue_cfg_count = 1;
+            queue_cfgs[0] = VkDeviceQueueCreateInfo{VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
+            queue_cfgs[0].queueFamilyIndex=queue_family; 
+            queue_cfgs[0].queueCount= transfer_family == queue_family ? transfer_queue_index + 1 : 1; 
+            queue_cfgs[0].pQueuePriorities=queue_priorities.data();
+
+            if (transfer_family != queue_family){
+                queue_cfgs[1] = VkDeviceQueueCreateInfo{VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
+                queue_cfgs[1].queueFamilyIndex=transfer_family;
+                queue_cfgs[1].queueCount=1;
+                queue_cfgs[1].pQueuePriorities=queue_priorities.data();
+                queue_cfg_count = 2;
+            }
+            queue_family_indices = { queue_family, transfer_family };
 
-            // Configure queue settings
-            VkDeviceQueueCreateInfo queue_cfg{VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO}; 
-            queue_cfg.queueFamilyIndex=queue_family; 
-            queue_cfg.queueCount=1; 
-            queue_cfg.pQueuePriorities=&queue_priority;
+            VkPhysicalDeviceProperties props{};
+            vkGetPhysicalDeviceProperties(device, &props);
+            unified_memory = props.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU || props.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU;
+
+            // Timeline semaphores are core in 1.2, without them async transfers fall back to the sync path
+            // as is buffer device address, which binding_model::buffer_address kernels need
+            VkPhysicalDeviceTimelineSemaphoreFeatures timeline_features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES};
+            VkPhysicalDeviceBufferDeviceAddressFeatures address_features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES};
+            const u32 requested_api = VK_MAKE_API_VERSION(api_version.variant, api_version.major, api_version.minor, 0);
+            if (props.apiVersion >= VK_API_VERSION_1_2 && requested_api >= VK_API_VERSION_1_2){
+                VkPhysicalDeviceFeatures2 features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2};
+                features.pNext = &timeline_features;
+                timeline_features.pNext = &address_features;
+                vkGetPhysicalDeviceFeatures2(device, &features);
+            }
+            timeline_semaphores = timeline_features.timelineSemaphore == VK_TRUE;
+            buffer_device_address = address_features.bufferDeviceAddress == VK_TRUE;
+
+            // Enable only what is used
+            VkPhysicalDeviceBufferDeviceAddressFeatures enabled_address{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES};
+            enabled_address.bufferDeviceAddress = VK_TRUE;
+            timeline_features.pNext = buffer_device_address ? &enabled_address : nullptr;
+            void* enabled_features = timeline_semaphores ? static_cast<void*>(&timeline_features)
+                                   : buffer_device_address ? static_cast<void*>(&enabled_address) : nullptr;
+
+            // Bindings go straight into the command buffer when the device has VK_KHR_push_descriptor
+            u32 extension_count = 0;
+            vkEnumerateDeviceExtensionProperties(device, nullptr, &extension_count, nullptr);
+            std::vector<VkExtensionProperties> extensions(extension_count);
+            vkEnumerateDeviceExtensionProperties(device, nullptr, &extension_count, extensions.data());
+            push_descriptors = std::any_of(extensions.begin(), extensions.end(), [](const auto& ext){
+                return std::strcmp(ext.extensionName, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) == 0;
+            });
+            std::vector<const char*> enabled_extensions;
+            if (push_descriptors) enabled_extensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
 
             // Configure device settings
             VkDeviceCreateInfo device_cfg{VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO}; 
-            device_cfg.queueCreateInfoCount=1; 
-            device_cfg.pQueueCreateInfos=&queue_cfg;
+            device_cfg.queueCreateInfoCount=queue_cfg_count; 
+            device_cfg.pQueueCreateInfos=queue_cfgs.data();
+            device_cfg.enabledExtensionCount=static_cast<u32>(enabled_extensions.size());
+            device_cfg.ppEnabledExtensionNames=enabled_extensions.data();
+            device_cfg.pNext = enabled_features;
 
             // Create device and assign to handle based on device settings
             if (vkCreateDevice(device, &device_cfg, nullptr, &device_handle) != VK_SUCCESS){ 
@@ -428,8 +1595,16 @@ namespace tether_io{
                 return false;
             }
 
+            if (push_descriptors){
+                cmd_push_descriptor_set = reinterpret_cast<PFN_vkCmdPushDescriptorSetKHR>(
+                    vkGetDeviceProcAddr(device_handle, "vkCmdPushDescriptorSetKHR")
+                );
+                push_descriptors = cmd_push_descriptor_set != nullptr;
+            }
+
             // Create queue and assign to handle based on queue settings
             vkGetDeviceQueue(device_handle, queue_family, 0, &queue_handle);
+            vkGetDeviceQueue(device_handle, transfer_family, transfer_queue_index, &transfer_queue);
 
             VkCommandPoolCreateInfo cpci{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
             cpci.queueFamilyIndex = queue_family;
@@ -441,22 +1616,216 @@ namespace tether_io{
                 return false;
             }
 
+            cpci.queueFamilyIndex = transfer_family;
+            if (vkCreateCommandPool(device_handle, &cpci, nullptr, &transfer_command_pool) != VK_SUCCESS){
+                transfer_command_pool = VK_NULL_HANDLE;
+                timeline_semaphores = false;
+            }
+
+            if (timeline_semaphores && (!create_timeline(transfer_timeline) || !create_timeline(compute_timeline))){
+                timeline_semaphores = false;
+            }
+
             return true;
         }
 
-        auto create_buffer_default(device_buffer<device_driver::vulkan_native>& buff) -> bool {
-            //std::cout << "create_buffer_default" << std::endl;
+        auto create_timeline(VkSemaphore& timeline) -> bool {
+            VkSemaphoreTypeCreateInfo stci{VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO};
+            stci.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+            stci.initialValue = 0;
+
+            VkSemaphoreCreateInfo sci{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+            sci.pNext = &stci;
+            if (vkCreateSemaphore(device_handle, &sci, nullptr, &timeline) != VK_SUCCESS){
+                timeline = VK_NULL_HANDLE;
+                return false;
+            }
+            return true;
+        }
+
+        // Submits command_buffers (may be none) to queue. With timelines it waits until wait_semaphore reaches
+        // wait_value (skipped for 0) and signals signal_semaphore with signal_value.
+        auto submit_with_timelines(
+            VkQueue queue, std::span<const VkCommandBuffer> command_buffers,
+            VkSemaphore wait_semaphore, u64 wait_value, VkPipelineStageFlags wait_stage,
+            VkSemaphore signal_semaphore, u64 signal_value,
+            VkFence fence
+        ) -> bool {
+            VkSubmitInfo si{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+            si.commandBufferCount = static_cast<u32>(command_buffers.size());
+            si.pCommandBuffers = command_buffers.data();
+
+            VkTimelineSemaphoreSubmitInfo tsi{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+            if (timeline_semaphores){
+                if (wait_value != 0){
+                    si.waitSemaphoreCount = 1;
+                    si.pWaitSemaphores = &wait_semaphore;
+                    si.pWaitDstStageMask = &wait_stage;
+                    tsi.waitSemaphoreValueCount = 1;
+                    tsi.pWaitSemaphoreValues = &wait_value;
+                }
+                si.signalSemaphoreCount = 1;
+                si.pSignalSemaphores = &signal_semaphore;
+                tsi.signalSemaphoreValueCount = 1;
+                tsi.pSignalSemaphoreValues = &signal_value;
+                si.pNext = &tsi;
+            }
+
+            return vkQueueSubmit(queue, 1, &si, fence) == VK_SUCCESS;
+        }
+
+        // Completed value of the transfer timeline. Runs the host copies of finished downloads, which also
+        // frees their staging slots for reuse.
+        auto retire_transfers() -> u64 {
+            if (!timeline_semaphores) return std::numeric_limits<u64>::max();
+
+            u64 completed = 0;
+            if (vkGetSemaphoreCounterValue(device_handle, transfer_timeline, &completed) != VK_SUCCESS){
+                return 0;
+            }
+
+            std::erase_if(pending_downloads, [&](const pending_download& download){
+                if (download.value > completed) return false;
+                std::memcpy(download.dest, download.src, download.size_bytes);
+                return true;
+            });
+            return completed;
+        }
+
+        // Index of a staging slot holding at least size_bytes that no in-flight transfer uses
+        auto acquire_staging_slot(usize size_bytes) -> std::expected<usize, device_error> {
+            const u64 completed = retire_transfers();
+
+            usize idx = staging_slots.size();
+            for (usize i = 0; i < staging_slots.size(); ++i){
+                if (staging_slots[i].release_value > completed) continue;
+                if (staging_slots[i].buff.size_bytes >= size_bytes) return i;
+                if (idx == staging_slots.size()) idx = i; // free but too small, grown below unless a fit shows up
+            }
+
+            if (idx == staging_slots.size()){
+                staging_slot slot{};
+                VkCommandBufferAllocateInfo cbai{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+                cbai.commandPool = transfer_command_pool;
+                cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                cbai.commandBufferCount = 1;
+                if (vkAllocateCommandBuffers(device_handle, &cbai, &slot.command_buffer) != VK_SUCCESS){
+                    return std::unexpected{device_error::alloc_failed};
+                }
+                staging_slots.push_back(slot);
+            }
+
+            auto& slot = staging_slots[idx];
+            destroy_buffer(slot.buff);
+            slot.buff.size_bytes = std::bit_ceil(size_bytes);
+            if (!create_buffer(
+                slot.buff,
+                VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+            )){
+                slot.buff.size_bytes = 0;
+                return std::unexpected{device_error::alloc_failed};
+            }
+            return idx;
+        }
+
+        // Records and submits a staging copy on the transfer queue. Uploads wait for the dispatches still using
+        // device_buff, downloads for the ones that wrote it. Returns the transfer timeline value it signals.
+        auto submit_transfer(
+            staging_slot& staging,
+            device_buffer<device_driver::vulkan_native>& device_buff,
+            usize size_bytes,
+            bool to_device
+        ) -> std::expected<u64, device_error> {
+            vkResetCommandBuffer(staging.command_buffer, 0);
+
+            VkCommandBufferBeginInfo cbbi{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+            cbbi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            if (vkBeginCommandBuffer(staging.command_buffer, &cbbi) != VK_SUCCESS){
+                return std::unexpected{device_error::unexpected_crash};
+            }
+
+            // Earlier copies into or out of device_buff on this queue (an upload_async the download has to read,
+            // a download the upload must not overwrite) are only ordered by this barrier, the semaphore waits
+            // cover compute
+            VkBufferMemoryBarrier hazard{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+            hazard.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            hazard.dstAccessMask = to_device ? VK_ACCESS_TRANSFER_WRITE_BIT : VK_ACCESS_TRANSFER_READ_BIT;
+            hazard.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            hazard.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            hazard.buffer = device_buff.buff_handle;
+            hazard.offset = 0;
+            hazard.size = VK_WHOLE_SIZE;
+            vkCmdPipelineBarrier(
+                staging.command_buffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0, 0, nullptr, 1, &hazard, 0, nullptr
+            );
+
+            VkBufferCopy region{};
+            region.size = size_bytes;
+            if (to_device){
+                // Visibility for the waiting dispatch comes with the semaphore signal
+                vkCmdCopyBuffer(staging.command_buffer, staging.buff.buff_handle, device_buff.buff_handle, 1, &region);
+            } else {
+                vkCmdCopyBuffer(staging.command_buffer, device_buff.buff_handle, staging.buff.buff_handle, 1, &region);
+
+                VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+                vkCmdPipelineBarrier(
+                    staging.command_buffer,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                    0, 1, &barrier, 0, nullptr, 0, nullptr
+                );
+            }
+
+            if (vkEndCommandBuffer(staging.command_buffer) != VK_SUCCESS){
+                return std::unexpected{device_error::unexpected_crash};
+            }
+
+            const u64 wait_compute = buffer_syncs[device_buff.buff_handle].compute_value;
+            if (!submit_with_timelines(
+                transfer_queue, std::span<const VkCommandBuffer>(&staging.command_buffer, 1),
+                compute_timeline, wait_compute, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                transfer_timeline, transfer_value + 1,
+                VK_NULL_HANDLE
+            )){
+                return std::unexpected{device_error::unexpected_crash};
+            }
+
+            staging.release_value = ++transfer_value;
+            return transfer_value;
+        }
+
+        // Empty transfer-queue submission: its timeline value is reached once compute has passed wait_compute
+        auto submit_transfer_wait(u64 wait_compute) -> std::expected<u64, device_error> {
+            if (!submit_with_timelines(
+                transfer_queue, {},
+                compute_timeline, wait_compute, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                transfer_timeline, transfer_value + 1,
+                VK_NULL_HANDLE
+            )){
+                return std::unexpected{device_error::unexpected_crash};
+            }
+            return ++transfer_value;
+        }
 
+        auto create_buffer(
+            device_buffer<device_driver::vulkan_native>& buff,
+            VkBufferUsageFlags usage,
+            VkMemoryPropertyFlags memory_flags
+        ) -> bool {
             // Specify settings of the buffer to be created and shared
+            const bool addressable = buffer_device_address && (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
             VkBufferCreateInfo buffer_cfg{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
-            //std::cout << "buff.size_bytes = " << buff.size_bytes << std::endl;
             buffer_cfg.size = buff.size_bytes; 
-            buffer_cfg.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT; 
-            buffer_cfg.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            buffer_cfg.usage = usage | (addressable ? VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT : 0); 
+            set_sharing_mode(buffer_cfg);
             
             // Create buffer on active devices
             if (vkCreateBuffer(device_handle, &buffer_cfg, nullptr, &buff.buff_handle) != VK_SUCCESS){
-                //std::cout << "!vkCreateBuffer()" << std::endl;
+                buff.buff_handle = VK_NULL_HANDLE;
                 return false;
             } 
            
@@ -465,38 +1834,325 @@ namespace tether_io{
             VkMemoryAllocateInfo alloc_cfg{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
 
             vkGetBufferMemoryRequirements(device_handle, buff.buff_handle, &memory_cfg);
-            //std::cout << "!vkGetBufferMemoryRequirements()" << std::endl;
 
             alloc_cfg.allocationSize = memory_cfg.size;
-            auto memory_type_idx = find_memory_type_index(
-                memory_cfg.memoryTypeBits, 
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-            );
-            //std::cout << "find_memory_type_index()" << std::endl;
+            auto memory_type_idx = find_memory_type_index(memory_cfg.memoryTypeBits, memory_flags);
 
+            // Allocate memmory and assign to buffer memory handle, then bind it to the buffer
             if (!memory_type_idx.has_value()) {
-                //std::cout << "!memory_type_idx.has_value()" << std::endl;
+                destroy_buffer(buff);
                 return false;
             }
 
-            //std::cout << "memory_type_idx.value() = " << memory_type_idx.value() << std::endl;
-
             alloc_cfg.memoryTypeIndex = memory_type_idx.value();
 
-            // Allocate memmory and assign to buffer memory handle
+            VkMemoryAllocateFlagsInfo alloc_flags{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO};
+            alloc_flags.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+            if (addressable) alloc_cfg.pNext = &alloc_flags;
+
             if (vkAllocateMemory(device_handle, &alloc_cfg, nullptr, &buff.memory_handle) != VK_SUCCESS){
-                //std::cout << "!vkAllocateMemory()" << std::endl;
+                buff.memory_handle = VK_NULL_HANDLE;
+                destroy_buffer(buff);
                 return false;
             } 
 
-            // Assign memory handle to buffer handle
             if (vkBindBufferMemory(device_handle, buff.buff_handle, buff.memory_handle, 0) != VK_SUCCESS ){
-                //std::cout << "!vkBindBufferMemory()" << std::endl;
+                destroy_buffer(buff);
                 return false;
             }
+            if (addressable) buff.address = buffer_address(buff.buff_handle);
+
+            // Host-visible memory is mapped once here, transfers and map() reuse the pointer
+            if ((memory_flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) &&
+                vkMapMemory(device_handle, buff.memory_handle, 0, VK_WHOLE_SIZE, 0, &buff.mapped) != VK_SUCCESS){
+                buff.mapped = nullptr;
+                destroy_buffer(buff);
+                return false;
+            }
+
+            return true;
+        }
+
+        auto buffer_address(VkBuffer buff) -> VkDeviceAddress {
+            VkBufferDeviceAddressInfo bdai{VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO};
+            bdai.buffer = buff;
+            return vkGetBufferDeviceAddress(device_handle, &bdai);
+        }
+
+        auto destroy_buffer(device_buffer<device_driver::vulkan_native>& buff) -> void {
+            if (buff.buff_handle != VK_NULL_HANDLE){
+                vkDestroyBuffer(device_handle, buff.buff_handle, nullptr);
+                buff.buff_handle = VK_NULL_HANDLE;
+            }
+
+            if (buff.memory_handle != VK_NULL_HANDLE){
+                // Freeing mapped memory unmaps it implicitly
+                vkFreeMemory(device_handle, buff.memory_handle, nullptr);
+                buff.memory_handle = VK_NULL_HANDLE;
+            }
+            buff.mapped = nullptr;
+        }
+
+        auto create_buffer_default(device_buffer<device_driver::vulkan_native>& buff) -> bool {
+            buff.host_visible = true;
+            return create_buffer(
+                buff,
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+            );
+        }
+
+        auto release_buffer(device_buffer<device_driver::vulkan_native>& buff) -> void {
+            if (buff.pool_block == ~0u){
+                destroy_buffer(buff);
+                return;
+            }
+
+            if (buff.buff_handle != VK_NULL_HANDLE){
+                vkDestroyBuffer(device_handle, buff.buff_handle, nullptr);
+                buff.buff_handle = VK_NULL_HANDLE;
+            }
+            if (buff.pool_block < pool_blocks.size()){
+                pool_blocks[buff.pool_block].allocator.free(buff.offset);
+            }
+            buff.memory_handle = VK_NULL_HANDLE;
+            buff.mapped = nullptr;
+            buff.pool_block = ~0u;
+        }
+
+        // Sub-allocates a device_local buffer from the pool, a new block is allocated when no existing block of
+        // the memory type has room. Requests larger than a block get a block of their own (rounded up).
+        auto create_buffer_pooled(device_buffer<device_driver::vulkan_native>& buff) -> std::expected<void, device_error> {
+            VkBufferCreateInfo buffer_cfg{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+            buffer_cfg.size = buff.size_bytes;
+            buffer_cfg.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            if (buffer_device_address) buffer_cfg.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+            set_sharing_mode(buffer_cfg);
+
+            if (vkCreateBuffer(device_handle, &buffer_cfg, nullptr, &buff.buff_handle) != VK_SUCCESS){
+                buff.buff_handle = VK_NULL_HANDLE;
+                return std::unexpected{device_error::could_not_create_buffer};
+            }
+
+            VkMemoryRequirements memory_cfg;
+            vkGetBufferMemoryRequirements(device_handle, buff.buff_handle, &memory_cfg);
+
+            // Same memory class as alloc_method::device_local
+            buff.host_visible = false;
+            std::expected<u32, device_error> memory_type_idx = std::unexpected{device_error::could_not_create_buffer};
+            if (unified_memory){
+                memory_type_idx = find_memory_type_index(
+                    memory_cfg.memoryTypeBits,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                );
+                buff.host_visible = memory_type_idx.has_value();
+            }
+            if (!memory_type_idx.has_value()){
+                memory_type_idx = find_memory_type_index(memory_cfg.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            }
+            if (!memory_type_idx.has_value()){
+                destroy_buffer(buff);
+                return std::unexpected{device_error::could_not_create_buffer};
+            }
+
+            // First block of the memory type with room, else a new one
+            std::expected<usize, device_error> offset = std::unexpected{device_error::alloc_failed};
+            u32 block_idx = 0;
+            for (; block_idx < pool_blocks.size(); ++block_idx){
+                auto& block = pool_blocks[block_idx];
+                if (block.memory == VK_NULL_HANDLE || block.memory_type != memory_type_idx.value()) continue;
+                offset = block.allocator.allocate(memory_cfg.size, memory_cfg.alignment);
+                if (offset.has_value()) break;
+            }
+
+            if (!offset.has_value()){
+                const usize block_bytes = std::max(pool_block_bytes, std::bit_ceil(static_cast<usize>(memory_cfg.size)));
+
+                VkMemoryAllocateInfo alloc_cfg{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+                alloc_cfg.allocationSize = block_bytes;
+                alloc_cfg.memoryTypeIndex = memory_type_idx.value();
+
+                // Every block is addressable, any buffer may end up in it
+                VkMemoryAllocateFlagsInfo alloc_flags{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO};
+                alloc_flags.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+                if (buffer_device_address) alloc_cfg.pNext = &alloc_flags;
+
+                pool_block block{ VK_NULL_HANDLE, nullptr, memory_type_idx.value(), buddy_allocator(block_bytes, pool_min_allocation) };
+                if (vkAllocateMemory(device_handle, &alloc_cfg, nullptr, &block.memory) != VK_SUCCESS){
+                    destroy_buffer(buff);
+                    return std::unexpected{device_error::alloc_failed};
+                }
+                if (buff.host_visible && vkMapMemory(device_handle, block.memory, 0, VK_WHOLE_SIZE, 0, &block.mapped) != VK_SUCCESS){
+                    vkFreeMemory(device_handle, block.memory, nullptr);
+                    destroy_buffer(buff);
+                    return std::unexpected{device_error::alloc_failed};
+                }
+
+                offset = block.allocator.allocate(memory_cfg.size, memory_cfg.alignment);
+
+                // Reuse a slot released by trim_pool before growing the list
+                auto slot = std::find_if(pool_blocks.begin(), pool_blocks.end(), [](const auto& b){ return b.memory == VK_NULL_HANDLE; });
+                block_idx = static_cast<u32>(slot - pool_blocks.begin());
+                if (slot == pool_blocks.end()) pool_blocks.push_back(std::move(block));
+                else *slot = std::move(block);
+            }
+
+            auto& block = pool_blocks[block_idx];
+            if (!offset.has_value() ||
+                vkBindBufferMemory(device_handle, buff.buff_handle, block.memory, offset.value()) != VK_SUCCESS){
+                if (offset.has_value()) block.allocator.free(offset.value());
+                destroy_buffer(buff);
+                return std::unexpected{device_error::alloc_failed};
+            }
+
+            buff.memory_handle = block.memory;
+            buff.offset = offset.value();
+            buff.pool_block = block_idx;
+            buff.mapped = block.mapped ? static_cast<u8*>(block.mapped) + buff.offset : nullptr;
+            if (buffer_device_address) buff.address = buffer_address(buff.buff_handle);
+            return {};
+        }
+
+        auto create_buffer_device_local(device_buffer<device_driver::vulkan_native>& buff) -> bool {
+            constexpr VkBufferUsageFlags usage = 
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+            // UMA: device-local memory the host can map, so transfers stay plain memcpys
+            if (unified_memory && create_buffer(
+                buff, usage,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+            )){
+                buff.host_visible = true;
+                return true;
+            }
+
+            buff.host_visible = false;
+            return create_buffer(buff, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        }
+
+        // Grows the staging buffer to hold size_bytes and lazily creates the transfer command buffer and fence
+        auto reserve_staging(usize size_bytes) -> bool {
+            if (staging_buffer.buff_handle == VK_NULL_HANDLE || staging_buffer.size_bytes < size_bytes){
+                destroy_buffer(staging_buffer);
+                staging_buffer.size_bytes = size_bytes;
+                if (!create_buffer(
+                    staging_buffer,
+                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                )){
+                    staging_buffer.size_bytes = 0;
+                    return false;
+                }
+            }
+
+            if (transfer_command_buffer == VK_NULL_HANDLE){
+                VkCommandBufferAllocateInfo cbai{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+                cbai.commandPool = command_pool;
+                cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                cbai.commandBufferCount = 1;
+                if (vkAllocateCommandBuffers(device_handle, &cbai, &transfer_command_buffer) != VK_SUCCESS){
+                    transfer_command_buffer = VK_NULL_HANDLE;
+                    return false;
+                }
+            }
+
+            if (transfer_lock == VK_NULL_HANDLE){
+                VkFenceCreateInfo fci{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+                if (vkCreateFence(device_handle, &fci, nullptr, &transfer_lock) != VK_SUCCESS){
+                    transfer_lock = VK_NULL_HANDLE;
+                    return false;
+                }
+            }
 
             return true;
         }
+
+        // Copies between the staging buffer and a device-local buffer on the compute queue and waits for it.
+        // The barriers order the copy after earlier dispatches that read or wrote the buffer and make the copied
+        // data visible to later dispatches (upload).
+        auto copy_staging_sync(
+            device_buffer<device_driver::vulkan_native>& device_buff,
+            usize size_bytes,
+            bool to_device
+        ) -> bool {
+            if (vkResetFences(device_handle, 1, &transfer_lock) != VK_SUCCESS){
+                return false;
+            }
+            vkResetCommandBuffer(transfer_command_buffer, 0);
+
+            VkCommandBufferBeginInfo cbbi{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+            cbbi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            if (vkBeginCommandBuffer(transfer_command_buffer, &cbbi) != VK_SUCCESS){
+                return false;
+            }
+
+            VkBufferCopy region{};
+            region.size = size_bytes;
+
+            VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+            if (to_device){
+                // Earlier dispatches may still read (or write) the old contents
+                VkBufferMemoryBarrier hazard{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+                hazard.srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+                hazard.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                hazard.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                hazard.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                hazard.buffer = device_buff.buff_handle;
+                hazard.offset = 0;
+                hazard.size = VK_WHOLE_SIZE;
+                vkCmdPipelineBarrier(
+                    transfer_command_buffer,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    0, 0, nullptr, 1, &hazard, 0, nullptr
+                );
+
+                vkCmdCopyBuffer(transfer_command_buffer, staging_buffer.buff_handle, device_buff.buff_handle, 1, &region);
+
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+                vkCmdPipelineBarrier(
+                    transfer_command_buffer,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    0, 1, &barrier, 0, nullptr, 0, nullptr
+                );
+            } else {
+                barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+                vkCmdPipelineBarrier(
+                    transfer_command_buffer,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    0, 1, &barrier, 0, nullptr, 0, nullptr
+                );
+
+                vkCmdCopyBuffer(transfer_command_buffer, device_buff.buff_handle, staging_buffer.buff_handle, 1, &region);
+
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+                vkCmdPipelineBarrier(
+                    transfer_command_buffer,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                    0, 1, &barrier, 0, nullptr, 0, nullptr
+                );
+            }
+
+            if (vkEndCommandBuffer(transfer_command_buffer) != VK_SUCCESS){
+                return false;
+            }
+
+            // Ordered after pending async uploads into the buffer, counts as compute-queue use of it
+            auto& sync = buffer_syncs[device_buff.buff_handle];
+            if (!submit_with_timelines(
+                queue_handle, std::span<const VkCommandBuffer>(&transfer_command_buffer, 1),
+                transfer_timeline, sync.transfer_value, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                compute_timeline, compute_value + 1,
+                transfer_lock
+            )){
+                return false;
+            }
+            if (timeline_semaphores) sync.compute_value = ++compute_value;
+
+            return vkWaitForFences(device_handle, 1, &transfer_lock, VK_TRUE, std::numeric_limits<u64>::max()) == VK_SUCCESS;
+        }
         
         template<typename T>
         auto upload_buffer_sync(
@@ -507,16 +2163,19 @@ namespace tether_io{
             if (src.size_bytes() > dest.size_bytes)
                 return false;
 
-            void* upload_handle = nullptr;
-            
-            // Bind device buffer and map to upload handle
-            vkMapMemory(device_handle, dest.memory_handle, 0, src.size_bytes(), 0, &upload_handle);
-            
-            // Copy host buffer to device buffer using upload handle
-            std::memcpy(upload_handle, src.data(), src.size_bytes());
+            if (!dest.host_visible){
+                if (src.size_bytes() == 0) return true;
+                if (!reserve_staging(src.size_bytes())) return false;
+
+                std::memcpy(staging_buffer.mapped, src.data(), src.size_bytes());
+                return copy_staging_sync(dest, src.size_bytes(), true);
+            }
 
-            // Unbind device buffer
-            vkUnmapMemory(device_handle, dest.memory_handle);
+            // Copy host buffer into the persistent mapping, nothing to do if it was written in place through map()
+            if (dest.mapped == nullptr) return false;
+            if (static_cast<const void*>(src.data()) != dest.mapped){
+                std::memcpy(dest.mapped, src.data(), src.size_bytes());
+            }
 
             return true;
         };
@@ -532,20 +2191,25 @@ namespace tether_io{
             // // Wait for kernel to finish using the data
             // vkWaitForFences(device_handle, 1, &src.lock, VK_TRUE, 1'000'000'000ull);
 
-            void* download_handle = nullptr;
-            
-            // Bind device buffer and map to upload handle
-            vkMapMemory(device_handle, src.memory_handle, 0, src.size_bytes, 0, &download_handle); 
-            
-            // Copy device buffer to host buffer using download handle
-            std::memcpy(dest.data(), download_handle, dest.size_bytes()); 
-            
-            // Unbind device buffer
-            vkUnmapMemory(device_handle, src.memory_handle);
+            if (!src.host_visible){
+                if (dest.size_bytes() == 0) return true;
+                if (!reserve_staging(dest.size_bytes())) return false;
+                if (!copy_staging_sync(src, dest.size_bytes(), false)) return false;
+
+                std::memcpy(dest.data(), staging_buffer.mapped, dest.size_bytes());
+                return true;
+            }
+
+            // Copy device buffer to host buffer out of the persistent mapping
+            if (src.mapped == nullptr) return false;
+            if (static_cast<const void*>(dest.data()) != src.mapped){
+                std::memcpy(dest.data(), src.mapped, dest.size_bytes());
+            }
 
             return true;
         }
 
+#ifdef USE_SHADERC
         auto find_shaderrc_vulkan_shader_version(version<u32> ver) -> std::expected<shaderc_env_version, device_error>{
             if (ver.major == 1 && ver.minor == 0) return shaderc_env_version_vulkan_1_0;
             if (ver.major == 1 && ver.minor == 1) return shaderc_env_version_vulkan_1_1;
@@ -554,8 +2218,106 @@ namespace tether_io{
             if (ver.major == 1 && ver.minor == 4) return shaderc_env_version_vulkan_1_4;
             return std::unexpected{device_error::shader_version_or_type_not_supported};
         }
+#endif // USE_SHADERC
+
+        // Binaries are tagged with a hash of everything that goes into them: the GLSL source, the target
+        // environment and the shader stage. The tag lives next to the binary as <name>.spv.hash.
+        static auto kernel_source_hash(const kernel_config& krnl_opts, const str& source) -> str {
+            u64 hash = 0xcbf29ce484222325ull; // FNV-1a 64
+            auto mix = [&](std::string_view bytes){
+                for (unsigned char c : bytes){
+                    hash ^= c;
+                    hash *= 0x100000001b3ull;
+                }
+            };
+            mix(source);
+            mix("|vulkan" + std::to_string(krnl_opts.type_version.major) + "." + std::to_string(krnl_opts.type_version.minor) + "|compute|" + krnl_opts.name);
+
+            constexpr char digits[] = "0123456789abcdef";
+            str out(16, '0');
+            for (usize i = 0; i < 16; ++i){
+                out[15 - i] = digits[(hash >> (4 * i)) & 0xFu];
+            }
+            return out;
+        }
+
+        // Kernel compiled into the executable by the build, empty when there is none
+        static auto find_embedded_spv(const kernel_config& krnl_opts) -> std::span<const u32> {
+#ifdef TETHER_IO_EMBEDDED_KERNELS
+            for (const auto& entry : embedded_kernels::table){
+                if (entry.name == krnl_opts.name) return entry.words;
+            }
+#else
+            (void)krnl_opts;
+#endif // TETHER_IO_EMBEDDED_KERNELS
+            return {};
+        }
+
+        static auto hash_file_path(const kernel_config& krnl_opts) -> std::filesystem::path {
+            std::filesystem::path path = krnl_opts.path_bin;
+            path += ".hash";
+            return path;
+        }
+
+        static auto read_text_file(const std::filesystem::path& path) -> std::expected<str, device_error> {
+            std::ifstream file(path, std::ios::binary);
+            if (!file){
+                return std::unexpected{device_error::could_not_compile_shader};
+            }
+            return str((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        }
+
+        static auto read_spv_file(const std::filesystem::path& path) -> std::expected<std::vector<u32>, device_error> {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file){
+                return std::unexpected{device_error::could_not_update_kernel_module};
+            }
+
+            const auto size = static_cast<usize>(file.tellg());
+            if (size < sizeof(u32) || size % sizeof(u32) != 0){
+                return std::unexpected{device_error::could_not_update_kernel_module};
+            }
+
+            std::vector<u32> words(size / sizeof(u32));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(words.data()), static_cast<std::streamsize>(size));
+
+            // SPIR-V magic number, anything else is a truncated or foreign file
+            if (!file || words[0] != 0x07230203u){
+                return std::unexpected{device_error::could_not_update_kernel_module};
+            }
+            return words;
+        }
+
+        // recompile = false: load path_bin when its stored hash matches the current source, rebuild it otherwise.
+        // Without a source file next to it (binary-only deployment) the binary is used as is.
+        auto load_or_compile_spv(kernel_config& krnl_opts) -> std::expected<std::vector<u32>, device_error>{
+            auto source = read_text_file(krnl_opts.path);
+            if (!source.has_value()){
+                return read_spv_file(krnl_opts.path_bin);
+            }
+
+            auto stored = read_text_file(hash_file_path(krnl_opts));
+            if (stored.has_value() && stored.value() == kernel_source_hash(krnl_opts, source.value())){
+                auto spv = read_spv_file(krnl_opts.path_bin);
+                if (spv.has_value()) return spv;
+            }
+
+            return compile_glsl_to_spv(krnl_opts, source.value());
+        }
 
         auto compile_glsl_to_spv(kernel_config& krnl_opts) -> std::expected<std::vector<u32>, device_error>{
+            auto source = read_text_file(krnl_opts.path);
+            if (!source.has_value()) return std::unexpected{source.error()};
+            return compile_glsl_to_spv(krnl_opts, source.value());
+        }
+
+        auto compile_glsl_to_spv(kernel_config& krnl_opts, const str& kernel_raw) -> std::expected<std::vector<u32>, device_error>{
+#ifndef USE_SHADERC
+            // Built without shaderc, only embedded or up-to-date precompiled binaries can be used
+            (void)krnl_opts; (void)kernel_raw;
+            return std::unexpected{device_error::could_not_compile_shader};
+#else
             
             // Check if compute context version is compatible with shaderrc version
             shaderc::Compiler comp; 
@@ -564,27 +2326,33 @@ namespace tether_io{
             if(!shaderrc_version.has_value()) return std::unexpected{shaderrc_version.error()};
 
             opts.SetTargetEnvironment(shaderc_target_env_vulkan, shaderrc_version.value());
-            
-            // Load glsl shader into raw data
-            std::ifstream kernel_file(krnl_opts.path);
-            str kernel_raw((std::istreambuf_iterator<char>(kernel_file)), std::istreambuf_iterator<char>());
-            kernel_file.close();
 
             // Compile shader into SpvCompilationResult vector
-            auto shader_bin_obj = comp.CompileGlslToSpv(kernel_raw, shaderc_compute_shader, krnl_opts.name.c_str());
+            auto shader_bin_obj = comp.CompileGlslToSpv(kernel_raw, shaderc_compute_shader, krnl_opts.name.c_str(), opts);
             if (shader_bin_obj.GetCompilationStatus() != shaderc_compilation_status_success) {
                 return std::unexpected{device_error::could_not_compile_shader};
             }
 
-            // Convert SpvCompilationResult vector into raw u32 vector and store binary in seperate file for later
+            // Convert SpvCompilationResult vector into raw u32 vector and store binary in seperate file for later,
+            // the hash tag is written last so an interrupted write leaves a binary that is detected as stale
             std::vector<u32> shader_bin(shader_bin_obj.cbegin(), shader_bin_obj.cend());
+            std::error_code ec;
+            std::filesystem::create_directories(krnl_opts.path_bin.parent_path(), ec);
+            std::filesystem::remove(hash_file_path(krnl_opts), ec);
+
             std::ofstream outFile(krnl_opts.path_bin, std::ios::binary);
             outFile.write(reinterpret_cast<const char*>(shader_bin.data()),
                         shader_bin.size() * sizeof(u32));
             outFile.close();
 
+            if (outFile){
+                std::ofstream hash_file(hash_file_path(krnl_opts), std::ios::binary | std::ios::trunc);
+                hash_file << kernel_source_hash(krnl_opts, kernel_raw);
+            }
+
             // Return raw u32 vector representing spv binary as words.
             return shader_bin;
+#endif // USE_SHADERC
         }
 
         auto register_spv_to_pipeline(
@@ -592,11 +2360,15 @@ namespace tether_io{
             std::initializer_list<device_buffer<device_driver::vulkan_native>> buffers,
             std::vector<u32>& spv_binary,
             kernel<device_driver::vulkan_native>& krnl,
-            vec3<u32> work_group_size
+            vec3<u32> work_group_size,
+            std::span<const u32> specialization
         ) -> std::expected<void, device_error> {
+            krnl.binding = krnl_opts.binding;
+            const bool descriptors = krnl.binding == binding_model::descriptors;
+
             // Configure descriptors for each needed buffer for kernel
             std::vector<VkDescriptorSetLayoutBinding> dslb;
-            dslb.resize(buffers.size());
+            dslb.resize(descriptors ? buffers.size() : 0);
 
             for (i32 i=0; i<dslb.size(); ++i){ 
                 dslb[i].binding=i; 
@@ -609,8 +2381,9 @@ namespace tether_io{
             VkDescriptorSetLayoutCreateInfo dlci{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO}; 
             dlci.bindingCount=dslb.size(); 
             dlci.pBindings=dslb.data();
+            if (push_descriptors) dlci.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
             
-            if (vkCreateDescriptorSetLayout(device_handle, &dlci, nullptr, &krnl.descriptor_layout) != VK_SUCCESS ){
+            if (descriptors && vkCreateDescriptorSetLayout(device_handle, &dlci, nullptr, &krnl.descriptor_layout) != VK_SUCCESS ){
                 return std::unexpected{device_error::could_not_update_descriptors};
             }
 
@@ -622,8 +2395,8 @@ namespace tether_io{
 
             // Configure pipeline with buffer and kernel params info
             VkPipelineLayoutCreateInfo plci{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO}; 
-            plci.setLayoutCount=1; 
-            plci.pSetLayouts=&krnl.descriptor_layout; 
+            plci.setLayoutCount=descriptors ? 1 : 0; 
+            plci.pSetLayouts=descriptors ? &krnl.descriptor_layout : nullptr; 
             plci.pushConstantRangeCount=1; 
             plci.pPushConstantRanges=&pcr;
             
@@ -647,11 +2420,13 @@ namespace tether_io{
                 return std::unexpected{device_error::could_not_update_kernel_module};
             };
 
-            std::array<u32, 3> work_group_size_values{
+            // constant_id 0..2 are the workgroup size, the kernel specific constants follow
+            std::vector<u32> work_group_size_values{
                 work_group_size.x, work_group_size.y, work_group_size.z
             };
+            work_group_size_values.insert(work_group_size_values.end(), specialization.begin(), specialization.end());
 
-            std::array<VkSpecializationMapEntry, 3> specialization_entries{};
+            std::vector<VkSpecializationMapEntry> specialization_entries(work_group_size_values.size());
             for (uint32_t idx = 0; idx < specialization_entries.size(); ++idx){
                 specialization_entries[idx].constantID = idx;
                 specialization_entries[idx].offset = idx * sizeof(uint32_t);
@@ -676,7 +2451,7 @@ namespace tether_io{
             cpci.stage=ss; 
             cpci.layout=krnl.pipeline_layout;
             
-            if (vkCreateComputePipelines(device_handle, VK_NULL_HANDLE, 1, &cpci, nullptr, &krnl.pipeline) != VK_SUCCESS){
+            if (vkCreateComputePipelines(device_handle, pipeline_cache, 1, &cpci, nullptr, &krnl.pipeline) != VK_SUCCESS){
                 vkDestroyShaderModule(device_handle, sm, nullptr);
                 vkDestroyPipelineLayout(device_handle, krnl.pipeline_layout, nullptr);
                 krnl.pipeline_layout = VK_NULL_HANDLE;
@@ -686,31 +2461,12 @@ namespace tether_io{
             }
             vkDestroyShaderModule(device_handle, sm, nullptr);
 
-            // Confgure descriptor pool to send buffers
-            VkDescriptorPoolSize dps{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, static_cast<u32>(buffers.size())};
-            VkDescriptorPoolCreateInfo dpci{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO}; 
-            dpci.poolSizeCount=1; 
-            dpci.pPoolSizes=&dps; 
-            dpci.maxSets=1;
-            
-            if (vkCreateDescriptorPool(device_handle, &dpci, nullptr, &krnl.descriptor_pool) != VK_SUCCESS){
-                vkDestroyPipeline(device_handle, krnl.pipeline, nullptr);
-                krnl.pipeline = VK_NULL_HANDLE;
-                vkDestroyPipelineLayout(device_handle, krnl.pipeline_layout, nullptr);
-                krnl.pipeline_layout = VK_NULL_HANDLE;
-                vkDestroyDescriptorSetLayout(device_handle, krnl.descriptor_layout, nullptr);
-                krnl.descriptor_layout = VK_NULL_HANDLE;
-                return std::unexpected{device_error::could_not_update_descriptors};
-            }
-
             VkCommandBufferAllocateInfo cbai{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
             cbai.commandPool = command_pool;
             cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
             cbai.commandBufferCount = 1;
 
             if (vkAllocateCommandBuffers(device_handle, &cbai, &krnl.command_buffer) != VK_SUCCESS){
-                vkDestroyDescriptorPool(device_handle, krnl.descriptor_pool, nullptr);
-                krnl.descriptor_pool = VK_NULL_HANDLE;
                 vkDestroyPipeline(device_handle, krnl.pipeline, nullptr);
                 krnl.pipeline = VK_NULL_HANDLE;
                 vkDestroyPipelineLayout(device_handle, krnl.pipeline_layout, nullptr);
@@ -720,70 +2476,175 @@ namespace tether_io{
                 return std::unexpected{device_error::could_not_register_kernel};
             }
 
+            // One fence per kernel for its whole lifetime, created signaled so the first launch does not wait
+            VkFenceCreateInfo fci{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+            fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+            if (vkCreateFence(device_handle, &fci, nullptr, &krnl.lock) != VK_SUCCESS){
+                krnl.lock = VK_NULL_HANDLE;
+                destroy_kernel(krnl);
+                return std::unexpected{device_error::could_not_register_kernel};
+            }
+
             return {};
 
 
         }
 
-        auto update_descriptor_sets(
+        static auto buffer_infos(
+            std::initializer_list<device_buffer<device_driver::vulkan_native>> buffs
+        ) -> std::vector<VkDescriptorBufferInfo> {
+            std::vector<VkDescriptorBufferInfo> dbis;
+            dbis.reserve(buffs.size());
+            for (const auto& buff : buffs){
+                dbis.push_back(VkDescriptorBufferInfo{ buff.buff_handle, 0, buff.size_bytes });
+            }
+            return dbis;
+        }
+
+        static auto descriptor_writes(
+            VkDescriptorSet set, const std::vector<VkDescriptorBufferInfo>& dbis
+        ) -> std::vector<VkWriteDescriptorSet> {
+            std::vector<VkWriteDescriptorSet> write_descriptors(dbis.size());
+            for (u32 i=0; i<dbis.size(); ++i){ 
+                write_descriptors[i].sType=VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET; 
+                write_descriptors[i].dstSet=set; 
+                write_descriptors[i].dstBinding=i; 
+                write_descriptors[i].descriptorCount=1; 
+                write_descriptors[i].descriptorType=VK_DESCRIPTOR_TYPE_STORAGE_BUFFER; 
+                write_descriptors[i].pBufferInfo=&dbis[i]; 
+            }
+            return write_descriptors;
+        }
+
+        // Points task.descriptor at the cached set for buffs, allocating and writing it on the first launch
+        // with these buffers. With push descriptors record_dispatch() writes the bindings instead.
+        auto bind_descriptor_set(
             kernel<device_driver::vulkan_native>& task,
             std::initializer_list<device_buffer<device_driver::vulkan_native>> buffs
         ) -> bool{
-            if (task.descriptor_pool == VK_NULL_HANDLE || task.descriptor_layout == VK_NULL_HANDLE){
+            if (task.binding == binding_model::buffer_address){
+                return true;
+            }
+            if (task.descriptor_layout == VK_NULL_HANDLE){
                 return false;
             }
+            if (push_descriptors){
+                return true;
+            }
 
-            if (vkResetDescriptorPool(device_handle, task.descriptor_pool, 0) != VK_SUCCESS){
-                return false;
+            auto& cache = descriptor_caches[task.pipeline];
+            descriptor_cache::key key;
+            key.reserve(buffs.size());
+            for (const auto& buff : buffs) key.emplace_back(buff.buff_handle, buff.size_bytes);
+
+            if (auto hit = cache.sets.find(key); hit != cache.sets.end()){
+                task.descriptor = hit->second.first;
+                return true;
             }
 
-            // Configure new descriptor layout
-            VkDescriptorSetAllocateInfo dsai{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO}; 
-            dsai.descriptorPool=task.descriptor_pool; 
-            dsai.descriptorSetCount=1; 
-            dsai.pSetLayouts=&task.descriptor_layout;
+            // Sets come from the first pool with room, a new one is added once all are exhausted (or fragmented)
+            auto allocate_set = [&](VkDescriptorPool pool, VkDescriptorSet& set) -> bool {
+                VkDescriptorSetAllocateInfo dsai{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO}; 
+                dsai.descriptorPool=pool; 
+                dsai.descriptorSetCount=1; 
+                dsai.pSetLayouts=&task.descriptor_layout;
+                return vkAllocateDescriptorSets(device_handle, &dsai, &set) == VK_SUCCESS;
+            };
 
-            if(vkAllocateDescriptorSets(device_handle, &dsai, &task.descriptor) != VK_SUCCESS){
-                return false;
+            VkDescriptorSet set{};
+            auto slot = std::find_if(cache.pools.begin(), cache.pools.end(), [&](const auto& candidate){
+                return candidate.free != 0 && allocate_set(candidate.pool, set);
+            });
+            if (slot == cache.pools.end()){
+                VkDescriptorPoolSize dps{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, static_cast<u32>(buffs.size()) * descriptor_pool_sets};
+                VkDescriptorPoolCreateInfo dpci{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO}; 
+                dpci.flags=VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+                dpci.poolSizeCount=1; 
+                dpci.pPoolSizes=&dps; 
+                dpci.maxSets=descriptor_pool_sets;
+
+                VkDescriptorPool pool{};
+                if (vkCreateDescriptorPool(device_handle, &dpci, nullptr, &pool) != VK_SUCCESS){
+                    return false;
+                }
+                cache.pools.push_back({ pool, descriptor_pool_sets });
+                slot = std::prev(cache.pools.end());
+                if (!allocate_set(pool, set)){
+                    return false;
+                }
             }
+            --slot->free;
 
-            // Assign buffers to descriptor layout
-            std::vector<VkDescriptorBufferInfo> dbis;
-            dbis.resize(buffs.size());
+            const auto dbis = buffer_infos(buffs);
+            const auto write_descriptors = descriptor_writes(set, dbis);
+            vkUpdateDescriptorSets(device_handle, static_cast<u32>(write_descriptors.size()), write_descriptors.data(), 0, nullptr);
 
-            for(u32 i=0; i<buffs.size(); ++i){
-                auto buff = *std::next(buffs.begin(), i);
+            cache.sets.emplace(std::move(key), std::pair{ set, slot->pool });
+            task.descriptor = set;
+            return true;
+        }
 
-                dbis[i] = VkDescriptorBufferInfo{
-                    buff.buff_handle,
-                    0,
-                    buff.size_bytes
-                };
+        // Drops the cached sets binding buff, called before the buffer is destroyed. Their pools take new sets
+        // again, pools left without any are destroyed.
+        auto evict_descriptor_sets(VkBuffer buff) -> void {
+            for (auto& [pipeline, cache] : descriptor_caches){
+                std::erase_if(cache.sets, [&](const auto& entry){
+                    const bool binds = std::any_of(entry.first.begin(), entry.first.end(), [&](const auto& b){ return b.first == buff; });
+                    if (!binds) return false;
+                    vkFreeDescriptorSets(device_handle, entry.second.second, 1, &entry.second.first);
+                    auto slot = std::find_if(cache.pools.begin(), cache.pools.end(), [&](const auto& s){ return s.pool == entry.second.second; });
+                    if (slot != cache.pools.end()) ++slot->free;
+                    return true;
+                });
+                std::erase_if(cache.pools, [&](const auto& slot){
+                    if (slot.free != descriptor_pool_sets) return false;
+                    vkDestroyDescriptorPool(device_handle, slot.pool, nullptr);
+                    return true;
+                });
             }
+        }
 
-            // Create write descriptors for transfer of buffers to sm
-            std::vector<VkWriteDescriptorSet> write_descriptors;
-            write_descriptors.resize(buffs.size());
+        auto destroy_descriptor_cache(VkPipeline pipeline) -> void {
+            if (auto it = descriptor_caches.find(pipeline); it != descriptor_caches.end()){
+                for (const auto& slot : it->second.pools) vkDestroyDescriptorPool(device_handle, slot.pool, nullptr);
+                descriptor_caches.erase(it);
+            }
+        }
 
-            for (i32 i=0; i<buffs.size(); ++i){ 
-                write_descriptors[i].sType=VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET; 
-                write_descriptors[i].dstSet=task.descriptor; 
-                write_descriptors[i].dstBinding=i; 
-                write_descriptors[i].descriptorCount=1; 
-                write_descriptors[i].descriptorType=VK_DESCRIPTOR_TYPE_STORAGE_BUFFER; 
-                write_descriptors[i].pBufferInfo=&dbis[i]; 
+        template<class_type KernelParams>
+        auto record_dispatch(
+            VkCommandBuffer command_buffer,
+            const kernel<device_driver::vulkan_native>& task,
+            vec3<u32> workgroup_size,
+            std::initializer_list<device_buffer<device_driver::vulkan_native>> buffers,
+            const KernelParams& kernel_params
+        ) -> void {
+            // Bind updated pipeline and descripor sets
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, task.pipeline);
+            if (task.binding == binding_model::buffer_address){
+                // Buffer pointers are part of kernel_params
+            } else if (push_descriptors){
+                const auto dbis = buffer_infos(buffers);
+                const auto write_descriptors = descriptor_writes(VK_NULL_HANDLE, dbis);
+                cmd_push_descriptor_set(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, task.pipeline_layout, 0, static_cast<u32>(write_descriptors.size()), write_descriptors.data());
+            } else {
+                vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, task.pipeline_layout, 0, 1, &task.descriptor, 0, nullptr);
             }
 
-            vkUpdateDescriptorSets(device_handle, buffs.size(), write_descriptors.data(), 0, nullptr);
+            // Push kernel params for launch 
+            vkCmdPushConstants(command_buffer, task.pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(KernelParams), &kernel_params);
 
-            return true;
+            // Set workgroup size
+            vkCmdDispatch(command_buffer, workgroup_size.x, workgroup_size.y, workgroup_size.z);
         }
 
         template<class_type KernelParams>
         auto dispatch_kernel_to_command_buffer(
             kernel<device_driver::vulkan_native>& task, 
             vec3<u32> workgroup_size, 
-            KernelParams kernel_params
+            std::initializer_list<device_buffer<device_driver::vulkan_native>> buffers,
+            KernelParams kernel_params,
+            u64 wait_transfer = 0
         ) -> bool {
             // Configure command buffer info
             if (task.command_buffer == VK_NULL_HANDLE){
@@ -798,39 +2659,28 @@ namespace tether_io{
                 return false;
             }
 
-            // Bind updated pipeline and descripor sets
-            vkCmdBindPipeline(task.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, task.pipeline);
-            vkCmdBindDescriptorSets(task.command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, task.pipeline_layout, 0, 1, &task.descriptor, 0, nullptr);
-
-            // Push kernel params for launch 
-            vkCmdPushConstants(task.command_buffer, task.pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(KernelParams), &kernel_params);
-
-            // Set workgroup size
-            vkCmdDispatch(task.command_buffer, workgroup_size.x, workgroup_size.y, workgroup_size.z);
+            record_dispatch(task.command_buffer, task, workgroup_size, buffers, kernel_params);
             
             // End command buffer
             if(vkEndCommandBuffer(task.command_buffer) != VK_SUCCESS){
                 return false;
             }
 
-            // Submit command buffer to queue
-            VkSubmitInfo si{VK_STRUCTURE_TYPE_SUBMIT_INFO}; 
-            si.commandBufferCount=1; 
-            si.pCommandBuffers=&task.command_buffer;
-            
-            // Create fence to indicate compute has finshed
-            VkFenceCreateInfo fci{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO}; 
-            if (task.lock != VK_NULL_HANDLE){
-                vkDestroyFence(device_handle, task.lock, nullptr);
-                task.lock = VK_NULL_HANDLE;
-            }
-            if(vkCreateFence(device_handle, &fci, nullptr, &task.lock) != VK_SUCCESS){
+            // Rearm the kernel's fence to indicate compute has finshed
+            if(task.lock == VK_NULL_HANDLE || vkResetFences(device_handle, 1, &task.lock) != VK_SUCCESS){
                 return false;
             }
             
-            if(vkQueueSubmit(queue_handle, 1, &si, task.lock) != VK_SUCCESS){
+            // Submit command buffer to queue, after the async uploads it reads have landed
+            if(!submit_with_timelines(
+                queue_handle, std::span<const VkCommandBuffer>(&task.command_buffer, 1),
+                transfer_timeline, wait_transfer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                compute_timeline, compute_value + 1,
+                task.lock
+            )){
                 return false;
             }
+            if (timeline_semaphores) ++compute_value;
 
             return true;
         }
@@ -4,9 +4,11 @@
 
 #include <algorithm>
 #include <expected>
+#include <map>
 #include <memory>
 #include <span>
 #include <thread>
+#include <tuple>
 #include <vector>
 
 #include <llama.h>
@@ -87,60 +89,50 @@ struct llama_vulkan_binmm_adapter{
         auto a_span = std::span<const f32>(static_cast<const f32*>(A->data), usize(m) * k_bits);
         auto b_span = std::span<const f32>(static_cast<const f32*>(B->data), usize(n) * k_bits);
 
-        auto pack_a = cpu_tools_.f32_mat_to_packed_u32(matrix_order::row_major, a_span, m, k_bits);
-        if (!pack_a.has_value()) return GGML_STATUS_FAILED;
-        auto pack_b = cpu_tools_.f32_mat_to_packed_u32(matrix_order::col_major, b_span, n, k_bits);
-        if (!pack_b.has_value()) return GGML_STATUS_FAILED;
-
-        act_bits_ = std::move(pack_a.value());
-        wt_bits_  = std::move(pack_b.value());
+        // Activations are packed straight into the mapped device buffer. Weights are too when their
+        // device-local memory is host visible (UMA), otherwise they are packed on the host and staged.
+        const u32 k_words = (k_bits + 31u) / 32u;
+        const usize act_words = usize(m) * k_words;
+        const usize wt_words  = usize(n) * k_words;
 
-        if (!ctx_.upload(d_act_, std::span<const u32>(act_bits_)).has_value()) 
+        auto act_mapped = ctx_.map<u32>(d_act_);
+        if (!act_mapped.has_value() || act_mapped.value().size() < act_words)
             return GGML_STATUS_FAILED;
-
-        if (!ctx_.upload(d_wt_, std::span<const u32>(wt_bits_)).has_value())
+        if (!cpu_tools_.f32_mat_to_packed_u32(matrix_order::row_major, a_span, act_mapped.value().first(act_words), m, k_bits).has_value())
             return GGML_STATUS_FAILED;
 
-        auto limits = ctx_.limits();
-        if (!limits.has_value()) return GGML_STATUS_FAILED;
-        const auto max_local = limits.value().max_compute_work_group_size;
-
-        auto choose_tile = [](u32 dim, u32 preferred, u32 max_dim) {
-            u32 capped = std::min(preferred, max_dim);
-            if (dim >= capped) return capped;
-            if (dim >= 8) return 8u;
-            if (dim >= 4) return 4u;
-            if (dim >= 2) return 2u;
-            return 1u;
-        };
-        auto ceil_div = [](u32 value, u32 tile) {
-            return (value + tile - 1u) / tile;
-        };
-
-        const u32 local_x = choose_tile(n, 16u, max_local.x);
-        const u32 local_y = choose_tile(m, 16u, max_local.y);
-        const vec3<u32> local_size{local_x, local_y, 1u};
-        const vec3<u32> grid_size{ceil_div(n, local_x), ceil_div(m, local_y), 1u};
-        const u32 k_words = (k_bits + 31u) / 32u;
+        auto wt_mapped = ctx_.map<u32>(d_wt_);
+        if (wt_mapped.has_value()){
+            if (wt_mapped.value().size() < wt_words)
+                return GGML_STATUS_FAILED;
+            if (!cpu_tools_.f32_mat_to_packed_u32(matrix_order::col_major, b_span, wt_mapped.value().first(wt_words), n, k_bits).has_value())
+                return GGML_STATUS_FAILED;
+        } else {
+            auto wt_view = std::span<u32>(wt_bits_).first(wt_words);
+            if (!cpu_tools_.f32_mat_to_packed_u32(matrix_order::col_major, b_span, wt_view, n, k_bits).has_value())
+                return GGML_STATUS_FAILED;
+            if (!ctx_.upload(d_wt_, std::span<const u32>(wt_view)).has_value())
+                return GGML_STATUS_FAILED;
+        }
 
-        auto res = device_kernel_->binmatmul(
-            grid_size,
-            local_size,
-            {d_act_, d_wt_, d_out_},
-            m, n, k_bits, k_words);
-        if (!res.has_value()) return GGML_STATUS_FAILED;
+        // Decode nodes (m of a few tokens) run the GEMV kernel, prefill the 2D tiled one. Each shape is
+        // captured once, later calls replay it with a single submit.
+        auto graph = shape_graph(m, n, k_bits, k_words);
+        if (!graph.has_value()) return GGML_STATUS_FAILED;
 
-        res = ctx_.wait_for_last_kernel(1'000'000'000ull);
-        if (!res.has_value()) return GGML_STATUS_FAILED;
+        auto token = ctx_.replay(graph.value());
+        if (!token.has_value() || !ctx_.wait_for_launch(token.value(), 1'000'000'000ull).has_value())
+            return GGML_STATUS_FAILED;
 
-        auto out_view = std::span<i32>(out_accum_);
-        auto download = ctx_.download(out_view, d_out_);
-        if (!download.has_value()) return GGML_STATUS_FAILED;
+        // Results are converted directly out of the mapped output buffer
+        auto out_mapped = ctx_.map<i32>(d_out_);
+        if (!out_mapped.has_value() || out_mapped.value().size() < usize(m) * n)
+            return GGML_STATUS_FAILED;
 
         float* dst_data = static_cast<float*>(dst->data);
         std::transform(
-            out_view.begin(), 
-            out_view.begin() + usize(m) * n, 
+            out_mapped.value().begin(), 
+            out_mapped.value().begin() + usize(m) * n, 
             dst_data,
             [](i32 v) { return static_cast<float>(v); }
         );
@@ -153,40 +145,72 @@ private:
         llama_vulkan_binmm_adapter* adapter{};
     };
 
+    // Graphs record the current buffers, ensure_capacity() drops them all when it reallocates one. Every prefill
+    // token count is a new shape, past max_graphs_ the cache starts over instead of keeping their command buffers.
+    inline auto shape_graph(u32 m, u32 n, u32 k_bits, u32 k_words) -> std::expected<command_graph<device_driver::vulkan_native>, device_error> {
+        const auto key = std::tuple{ m, n, k_bits };
+        if (auto it = graphs_.find(key); it != graphs_.end()) return it->second;
+        if (graphs_.size() >= max_graphs_) destroy_graphs();
+
+        auto res = ctx_.begin_capture();
+        if (!res.has_value()) return std::unexpected{ res.error() };
+        res = device_kernel_->binmatmul({d_act_, d_wt_, d_out_}, m, n, k_bits, k_words);
+        if (!res.has_value()){
+            ctx_.cancel_sequence();
+            return std::unexpected{ res.error() };
+        }
+
+        auto graph = ctx_.end_capture();
+        if (!graph.has_value()) return std::unexpected{ graph.error() };
+        graphs_.emplace(key, graph.value());
+        return graph.value();
+    }
+
+    // Grows every buffer too small for this shape before anything is captured or replayed on it. A reallocated
+    // buffer invalidates the graphs recorded on the old one.
     inline auto ensure_capacity(u32 m, u32 n, u32 k_bits) -> std::expected<void, device_error> {
         const u32 k_words = (k_bits + 31u) / 32u;
-        const usize act_size = usize(m) * k_words;
-        const usize wt_size  = usize(n) * k_words;
-        const usize out_size = usize(m) * n;
+        const usize act_bytes = usize(m) * k_words * sizeof(u32);
+        const usize wt_bytes  = usize(n) * k_words * sizeof(u32);
+        const usize out_bytes = usize(m) * n * sizeof(i32);
 
-        if (m == cached_m_ && n == cached_n_ && k_bits == cached_k_bits_) return {};
+        // Host-side staging for weights only, activations and outputs live in mapped buffers
+        if (wt_bits_.size() < usize(n) * k_words) wt_bits_.resize(usize(n) * k_words);
 
-        if (act_bits_.size() < act_size) act_bits_.resize(act_size);
-        if (wt_bits_.size()  < wt_size)  wt_bits_.resize(wt_size);
-        if (out_accum_.size() < out_size) out_accum_.resize(out_size);
+        const bool fits = d_act_.buff_handle && d_act_.size_bytes >= act_bytes
+                       && d_wt_.buff_handle && d_wt_.size_bytes >= wt_bytes
+                       && d_out_.buff_handle && d_out_.size_bytes >= out_bytes;
+        if (fits) return {};
 
-        if (!d_act_.buff_handle) {
-            auto buf = ctx_.allocate(act_size * sizeof(u32));
+        destroy_graphs();
+
+        if (!d_act_.buff_handle || d_act_.size_bytes < act_bytes) {
+            if (d_act_.buff_handle) ctx_.free(d_act_);
+            auto buf = ctx_.allocate(act_bytes);
             if (!buf.has_value()) return std::unexpected{ buf.error() };
             d_act_ = buf.value();
         }
-        if (!d_wt_.buff_handle) {
-            auto buf = ctx_.allocate(wt_size * sizeof(u32));
+        if (!d_wt_.buff_handle || d_wt_.size_bytes < wt_bytes) {
+            if (d_wt_.buff_handle) ctx_.free(d_wt_);
+            // Weights are read by every dispatch, keep them in VRAM on discrete GPUs
+            auto buf = ctx_.allocate(wt_bytes, alloc_method::device_local);
             if (!buf.has_value()) return std::unexpected{ buf.error() };
             d_wt_ = buf.value();
         }
-        if (!d_out_.buff_handle) {
-            auto buf = ctx_.allocate(out_size * sizeof(i32));
+        if (!d_out_.buff_handle || d_out_.size_bytes < out_bytes) {
+            if (d_out_.buff_handle) ctx_.free(d_out_);
+            auto buf = ctx_.allocate(out_bytes);
             if (!buf.has_value()) return std::unexpected{ buf.error() };
             d_out_ = buf.value();
         }
-
-        cached_m_ = m;
-        cached_n_ = n;
-        cached_k_bits_ = k_bits;
         return {};
     }
 
+    inline auto destroy_graphs() -> void {
+        for (auto& [key, graph] : graphs_) ctx_.destroy_graph(graph);
+        graphs_.clear();
+    }
+
     application_config config_;
     compute_context<device_driver::vulkan_native> ctx_;
     std::unique_ptr<algorithm<device_driver::vulkan_native, execution_method::sequenced>> device_kernel_;
@@ -196,13 +220,11 @@ private:
     device_buffer<device_driver::vulkan_native> d_wt_{};
     device_buffer<device_driver::vulkan_native> d_out_{};
 
-    std::vector<u32> act_bits_;
     std::vector<u32> wt_bits_;
-    std::vector<i32> out_accum_;
+    std::map<std::tuple<u32, u32, u32>, command_graph<device_driver::vulkan_native>> graphs_;
 
-    u32 cached_m_{0};
-    u32 cached_n_{0};
-    u32 cached_k_bits_{0};
+    // Decode reuses a handful of shapes, this only bounds the prefill ones
+    static constexpr usize max_graphs_ = 64;
 };
 
 inline auto register_llama_vulkan_binmm_backend(llama_vulkan_binmm_adapter& adapter) -> ggml_backend_reg_t {
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <expected>
+#include <iostream>
+#include <span>
 #include <vector>
 #include <filesystem>
 
@@ -13,14 +17,19 @@ namespace tether_io {
 template<sandbox_algorithm A, device_driver D>
 struct sandbox;
 
+#ifdef TARGET_VULKAN_NATIVE
 
 template<> struct sandbox<sandbox_algorithm::binmatmul, device_driver::vulkan_native> {
 
+    // `kernel` empty runs the automatic binmatmul path with the variants of index.json, another entry name forces
+    // it as the "binmatmul" variant. "binmatmul_bda" runs the buffer-address kernel on a Vulkan 1.2 context
+    // instead, not_available when the device has no bufferDeviceAddress.
     auto run(
         data_domain domain,
         u32 M, 
         u32 N,
-        u32 K_bits
+        u32 K_bits,
+        const str& kernel = {}
     ) -> std::expected<sandbox_results<sandbox_algorithm::binmatmul>, device_error> {
 
         // Load config
@@ -29,6 +38,10 @@ template<> struct sandbox<sandbox_algorithm::binmatmul, device_driver::vulkan_na
             return std::unexpected{ device_error::init_failed }; 
         }
         config = cfg.value();
+        if (!kernel.empty() && kernel != "binmatmul_bda") {
+            if (!config.kernels.contains(kernel)) return std::unexpected{ device_error::not_available };
+            config.variants["binmatmul"] = kernel;
+        }
 
         u32 K_words = (K_bits + 31u) / 32u;
         A.resize(M * K_bits);
@@ -92,7 +105,8 @@ template<> struct sandbox<sandbox_algorithm::binmatmul, device_driver::vulkan_na
             B_bits, 
             M, 
             N, 
-            K_bits
+            K_bits,
+            cpu_isa::scalar
         );
 
         if(!C_host_res.has_value()) { 
@@ -102,7 +116,8 @@ template<> struct sandbox<sandbox_algorithm::binmatmul, device_driver::vulkan_na
         C_host = C_host_res.value();
         C_device.resize(C_host.size());
 
-        result = ctx.init(version<u32>{0, 1, 1, 0}, gen_app_name(domain, M, K_bits, N));
+        const bool buffer_address = kernel == "binmatmul_bda";
+        result = ctx.init(buffer_address ? version<u32>{0, 1, 2, 0} : version<u32>{0, 1, 1, 0}, gen_app_name(domain, M, K_bits, N));
         if(!result.has_value()) { 
             ctx.exit();
             return std::unexpected{result.error()}; 
@@ -114,6 +129,16 @@ template<> struct sandbox<sandbox_algorithm::binmatmul, device_driver::vulkan_na
             return std::unexpected{result.error()}; 
         }
 
+        auto device_limits_res = ctx.limits();
+        if (!device_limits_res.has_value()){
+            ctx.exit();
+            return std::unexpected{device_limits_res.error()}; 
+        }
+        if (buffer_address && !device_limits_res.value().buffer_device_address){
+            ctx.exit();
+            return std::unexpected{device_error::not_available}; 
+        }
+
         auto d_buff_A_res = ctx.allocate(A_bits.size() * sizeof(u32), alloc_method::base);
         if(!d_buff_A_res.has_value()) { 
             ctx.exit();
@@ -121,21 +146,29 @@ template<> struct sandbox<sandbox_algorithm::binmatmul, device_driver::vulkan_na
         }
         auto d_buff_A = d_buff_A_res.value();
 
-        auto d_buff_B_res = ctx.allocate(A_bits.size() * sizeof(u32), alloc_method::base);
+        // B and C are device-local so the staged upload and download paths are covered as well
+        auto d_buff_B_res = ctx.allocate(B_bits.size() * sizeof(u32), alloc_method::device_local);
         if(!d_buff_B_res.has_value()) {
             ctx.exit(); 
             return std::unexpected{d_buff_B_res.error()}; 
         }
         auto d_buff_B = d_buff_B_res.value();
         
-        auto d_buff_C_res = ctx.allocate(static_cast<usize>(M * N * sizeof(u32)), alloc_method::base);
+        auto d_buff_C_res = ctx.allocate(static_cast<usize>(M * N * sizeof(u32)), alloc_method::device_local);
         if(!d_buff_C_res.has_value()) { 
             ctx.exit();
             return std::unexpected{d_buff_C_res.error()}; 
         }
         auto d_buff_C = d_buff_C_res.value();
 
-        result = ctx.upload(d_buff_A, std::span<u32>{A_bits}, upload_method::sync);
+        // A is host visible: pack it in place through the persistent mapping instead of uploading A_bits
+        auto A_mapped = ctx.map<u32>(d_buff_A);
+        if(!A_mapped.has_value()) { 
+            ctx.exit();
+            return std::unexpected{A_mapped.error()}; 
+        }
+
+        result = host_kernel_launcher.f32_mat_to_packed_u32(matrix_order::row_major, A, A_mapped.value().first(A_bits.size()), M, K_bits);
         if(!result.has_value()) { 
             ctx.exit();
             return std::unexpected{result.error()}; 
@@ -152,6 +185,185 @@ template<> struct sandbox<sandbox_algorithm::binmatmul, device_driver::vulkan_na
             execution_method::sequenced
         > device_kernel_launcher(ctx, config);
 
+        if (buffer_address) {
+            // The 2D shape at every M, grid rows past M return early
+            const auto launch = binmatmul_launch_geometry(
+                device_limits_res.value().max_compute_work_group_size,
+                std::max(M, binmatmul_gemv_max_rows + 1u), N, K_words
+            );
+            result = device_kernel_launcher.binmatmul_bda(
+                launch.grid_size, launch.local_size,
+                {d_buff_A, d_buff_B, d_buff_C},
+                M, N, K_bits, K_words
+            );
+        } else {
+            // Launch shape and kernel come from the device limits: GEMV for M <= binmatmul_gemv_max_rows, 2D tiles otherwise
+            result = device_kernel_launcher.binmatmul(
+                {d_buff_A, d_buff_B, d_buff_C},
+                M, N, K_bits, K_words
+            );
+        }
+        if(!result.has_value()) { 
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        result = ctx.wait_for_last_kernel(1'000'000'000ull);
+
+        result = ctx.download(std::span<i32>{C_device}, d_buff_C, download_method::sync);
+        if (!result.has_value()){
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        ctx.exit();
+
+        i32 max_abs_err = 0; 
+        usize mismatches = 0;
+        for (usize i=0; i<C_device.size(); ++i){ 
+            i32 e = std::abs(C_device[i] - C_host[i]); 
+            if (e > max_abs_err) max_abs_err=e; 
+            if (e != 0) ++mismatches; 
+        }
+
+        return sandbox_results<sandbox_algorithm::binmatmul>{max_abs_err, mismatches, C_host.size()};
+
+    };
+
+private:
+    application_config config;
+    std::expected<void, device_error> result;
+    std::filesystem::path rsc = RESOURCE_DIR;
+    compute_context<device_driver::vulkan_native> ctx;
+    algorithm<device_driver::cpu_native, execution_method::standalone> host_kernel_launcher;
+    
+    std::vector<f32> A;
+    std::vector<f32> B;
+    std::vector<u32> A_bits;
+    std::vector<u32> B_bits;
+    std::vector<i32> C_host;
+    std::vector<i32> C_device;
+
+    auto gen_app_name(
+        data_domain domain,
+        u32 M, 
+        u32 K_bits, 
+        u32 N
+    ) -> str {
+        return 
+            to_string(sandbox_algorithm::binmatmul) + "_" +
+            to_string(domain) + "_" +
+            std::to_string(M) + "x" + 
+            std::to_string(N) + "[" +
+            std::to_string(K_bits) + "bit]";
+
+    };
+
+
+
+};
+
+// Runs the ternmatmul shader on two-bit-plane packed inputs and checks it against the unpacked f32 reference
+template<> struct sandbox<sandbox_algorithm::ternmatmul, device_driver::vulkan_native> {
+
+    auto run(
+        data_domain domain,
+        u32 M, 
+        u32 N,
+        u32 K_bits
+    ) -> std::expected<sandbox_results<sandbox_algorithm::ternmatmul>, device_error> {
+
+        // Load config
+        auto cfg = parse_application_settings(rsc / "settings.json");
+        if(!cfg.has_value()) { 
+            return std::unexpected{ device_error::init_failed }; 
+        }
+        config = cfg.value();
+
+        u32 K_words = (K_bits + 31u) / 32u;
+
+        auto A_res = host_kernel_launcher.random_mat_binary_f32_1d(domain, M, K_bits, 7937929);
+        if(!A_res.has_value()) { 
+            return std::unexpected{A_res.error()}; 
+        }
+        A = A_res.value();
+
+        auto B_res = host_kernel_launcher.random_mat_binary_f32_1d(domain, K_bits, N, 732973980);
+        if(!B_res.has_value()) { 
+            return std::unexpected{B_res.error()}; 
+        }
+        B = B_res.value();
+
+        auto A_planes_res = host_kernel_launcher.f32_mat_to_packed_ternary_u32(matrix_order::row_major, A, M, K_bits);
+        if(!A_planes_res.has_value()) { 
+            return std::unexpected{A_planes_res.error()}; 
+        }
+        A_planes = A_planes_res.value();
+
+        auto B_planes_res = host_kernel_launcher.f32_mat_to_packed_ternary_u32(matrix_order::col_major, B, N, K_bits);
+        if(!B_planes_res.has_value()) { 
+            return std::unexpected{B_planes_res.error()}; 
+        }
+        B_planes = B_planes_res.value();
+
+        auto C_host_res = host_kernel_launcher.ternmatmul_reference(A, B, M, N, K_bits);
+        if(!C_host_res.has_value()) { 
+            return std::unexpected{C_host_res.error()}; 
+        }
+        C_host = C_host_res.value();
+        C_device.resize(C_host.size());
+
+        result = ctx.init(version<u32>{0, 1, 1, 0}, gen_app_name(domain, M, K_bits, N));
+        if(!result.has_value()) { 
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+        
+        result = ctx.set_device(device_select::first_compute_capable);
+        if(!result.has_value()) { 
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        // Sub-allocated from the memory pool, the three operands share one block
+        auto d_buff_A_res = ctx.allocate(A_planes.size() * sizeof(u32), alloc_method::custom);
+        if(!d_buff_A_res.has_value()) { 
+            ctx.exit();
+            return std::unexpected{d_buff_A_res.error()}; 
+        }
+        auto d_buff_A = d_buff_A_res.value();
+
+        auto d_buff_B_res = ctx.allocate(B_planes.size() * sizeof(u32), alloc_method::custom);
+        if(!d_buff_B_res.has_value()) {
+            ctx.exit(); 
+            return std::unexpected{d_buff_B_res.error()}; 
+        }
+        auto d_buff_B = d_buff_B_res.value();
+        
+        auto d_buff_C_res = ctx.allocate(static_cast<usize>(M) * N * sizeof(i32), alloc_method::custom);
+        if(!d_buff_C_res.has_value()) { 
+            ctx.exit();
+            return std::unexpected{d_buff_C_res.error()}; 
+        }
+        auto d_buff_C = d_buff_C_res.value();
+
+        result = ctx.upload(d_buff_A, std::span<u32>{A_planes}, upload_method::sync);
+        if(!result.has_value()) { 
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        result = ctx.upload(d_buff_B, std::span<u32>{B_planes}, upload_method::sync);
+        if(!result.has_value()) { 
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        algorithm<
+            device_driver::vulkan_native, 
+            execution_method::sequenced
+        > device_kernel_launcher(ctx, config);
+
         auto device_limits_res = ctx.limits();
         if (!device_limits_res.has_value()){
             ctx.exit();
@@ -162,12 +374,9 @@ template<> struct sandbox<sandbox_algorithm::binmatmul, device_driver::vulkan_na
         u32 local_x = choose_tile(N, 16u, device_limits.max_compute_work_group_size.x);
         u32 local_y = choose_tile(M, 16u, device_limits.max_compute_work_group_size.y);
         vec3<u32> local_size{local_x, local_y, 1u};
+        vec3<u32> grid_size{ceil_div(N, local_x), ceil_div(M, local_y), 1u};
 
-        u32 groups_x = ceil_div(N, local_x);
-        u32 groups_y = ceil_div(M, local_y);
-        vec3<u32> grid_size{groups_x, groups_y, 1u};
-
-        result = device_kernel_launcher.binmatmul(
+        result = device_kernel_launcher.ternmatmul(
             grid_size,
             local_size,
             {d_buff_A, d_buff_B, d_buff_C},
@@ -196,8 +405,7 @@ template<> struct sandbox<sandbox_algorithm::binmatmul, device_driver::vulkan_na
             if (e != 0) ++mismatches; 
         }
 
-        return sandbox_results<sandbox_algorithm::binmatmul>{max_abs_err, mismatches, C_host.size()};
-
+        return sandbox_results<sandbox_algorithm::ternmatmul>{max_abs_err, mismatches, C_host.size()};
     };
 
 private:
@@ -209,19 +417,14 @@ private:
     
     std::vector<f32> A;
     std::vector<f32> B;
-    std::vector<u32> A_bits;
-    std::vector<u32> B_bits;
+    std::vector<u32> A_planes;
+    std::vector<u32> B_planes;
     std::vector<i32> C_host;
     std::vector<i32> C_device;
 
-    auto choose_tile(
-        u32 dim,
-        u32 preferred,
-        u32 max_local
-    ) -> u32 {
+    auto choose_tile(u32 dim, u32 preferred, u32 max_local) -> u32 {
         u32 capped = std::min(preferred, max_local);
         if (dim >= capped) return capped;
-        // fall back to the largest power-of-two ≤ dim
         if (dim >= 8) return 8u;
         if (dim >= 4) return 4u;
         if (dim >= 2) return 2u;
@@ -232,24 +435,526 @@ private:
         return (value + tile - 1u) / tile;
     };
 
-    auto gen_app_name(
-        data_domain domain,
-        u32 M, 
-        u32 K_bits, 
-        u32 N
-    ) -> str {
+    auto gen_app_name(data_domain domain, u32 M, u32 K_bits, u32 N) -> str {
         return 
-            to_string(sandbox_algorithm::binmatmul) + "_" +
+            to_string(sandbox_algorithm::ternmatmul) + "_" +
             to_string(domain) + "_" +
             std::to_string(M) + "x" + 
             std::to_string(N) + "[" +
             std::to_string(K_bits) + "bit]";
+    };
+
+};
+
+// fill_bda against the descriptor fill kernel. The BDA buffer is first filled with a sentinel through the descriptor
+// kernel, fill_bda then starts offset_bytes into it: the head has to keep the sentinel, the rest has to match.
+// Needs a Vulkan 1.2 device with bufferDeviceAddress, not_available otherwise.
+template<> struct sandbox<sandbox_algorithm::fill, device_driver::vulkan_native> {
+
+    auto run(
+        u32 count,
+        f32 fill_value,
+        usize offset_bytes
+    ) -> std::expected<sandbox_results<sandbox_algorithm::fill>, device_error> {
+
+        auto cfg = parse_application_settings(rsc / "settings.json");
+        if(!cfg.has_value()) { 
+            return std::unexpected{ device_error::init_failed }; 
+        }
+        config = cfg.value();
+
+        // fill launches work_group_size workgroups of work_group_size.x invocations: 64 x 64 elements
+        if (count == 0 || count > work_group_size.x * work_group_size.x || offset_bytes > count * sizeof(f32)){
+            return std::unexpected{ device_error::launch_failed };
+        }
+
+        result = ctx.init(version<u32>{0, 1, 2, 0}, gen_app_name(count, offset_bytes));
+        if(!result.has_value()) { 
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        result = ctx.set_device(device_select::first_compute_capable);
+        if(!result.has_value()) { 
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        auto device_limits_res = ctx.limits();
+        if (!device_limits_res.has_value()){
+            ctx.exit();
+            return std::unexpected{device_limits_res.error()}; 
+        }
+        if (!device_limits_res.value().buffer_device_address){
+            ctx.exit();
+            return std::unexpected{device_error::not_available}; 
+        }
+
+        auto d_buff_ref_res = ctx.allocate(count * sizeof(f32), alloc_method::base);
+        auto d_buff_bda_res = ctx.allocate(count * sizeof(f32), alloc_method::device_local);
+        if(!d_buff_ref_res.has_value() || !d_buff_bda_res.has_value()) { 
+            ctx.exit();
+            return std::unexpected{device_error::alloc_failed}; 
+        }
+        auto d_buff_ref = d_buff_ref_res.value();
+        auto d_buff_bda = d_buff_bda_res.value();
 
+        algorithm<
+            device_driver::vulkan_native, 
+            execution_method::sequenced
+        > device_kernel_launcher(ctx, config);
+
+        // The sentinel fill and fill_bda are different kernels writing the same buffer, nothing orders the
+        // second submission after the first but the wait in between
+        result = device_kernel_launcher.fill(work_group_size, d_buff_ref, fill_value);
+        if(result.has_value()) result = device_kernel_launcher.fill(work_group_size, d_buff_bda, sentinel);
+        if(result.has_value()) result = ctx.wait_for_last_kernel(1'000'000'000ull);
+        if(result.has_value()) result = device_kernel_launcher.fill_bda(work_group_size, d_buff_bda, fill_value, offset_bytes);
+        if(result.has_value()) result = ctx.wait_for_last_kernel(1'000'000'000ull);
+        if(!result.has_value()) { 
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        ref.resize(count);
+        out.resize(count);
+        result = ctx.download(std::span<f32>{ref}, d_buff_ref, download_method::sync);
+        if(result.has_value()) result = ctx.download(std::span<f32>{out}, d_buff_bda, download_method::sync);
+        if (!result.has_value()){
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        ctx.exit();
+
+        const usize head = offset_bytes / sizeof(f32);
+        f32 max_abs_err = 0.0f;
+        usize mismatches = 0;
+        for (usize i=0; i<count; ++i){ 
+            const f32 expected = i < head ? sentinel : fill_value;
+            f32 e = std::max(std::abs(ref[i] - fill_value), std::abs(out[i] - expected));
+            if (e > max_abs_err) max_abs_err=e; 
+            if (e != 0.0f) ++mismatches; 
+        }
+
+        return sandbox_results<sandbox_algorithm::fill>{max_abs_err, mismatches, count};
+    };
+
+private:
+    static constexpr vec3<u32> work_group_size{64u, 1u, 1u};
+    static constexpr f32 sentinel = -7.5f;
+
+    application_config config;
+    std::expected<void, device_error> result;
+    std::filesystem::path rsc = RESOURCE_DIR;
+    compute_context<device_driver::vulkan_native> ctx;
+
+    std::vector<f32> ref;
+    std::vector<f32> out;
+
+    auto gen_app_name(u32 count, usize offset_bytes) -> str {
+        return 
+            to_string(sandbox_algorithm::fill) + "_bda_" +
+            std::to_string(count) + "+" +
+            std::to_string(offset_bytes) + "B";
+    };
+
+};
+
+// multiply_bda against the descriptor multiply kernel on the same random data. multiply_bda starts offset_bytes
+// into its buffer: the head has to stay unscaled, the rest has to match. Needs a Vulkan 1.2 device with
+// bufferDeviceAddress, not_available otherwise.
+template<> struct sandbox<sandbox_algorithm::mull, device_driver::vulkan_native> {
+
+    auto run(
+        u32 count,
+        f32 mull_factor,
+        usize offset_bytes
+    ) -> std::expected<sandbox_results<sandbox_algorithm::mull>, device_error> {
+
+        auto cfg = parse_application_settings(rsc / "settings.json");
+        if(!cfg.has_value()) { 
+            return std::unexpected{ device_error::init_failed }; 
+        }
+        config = cfg.value();
+
+        // multiply launches work_group_size workgroups of work_group_size.x invocations: 64 x 64 elements
+        if (count == 0 || count > work_group_size.x * work_group_size.x || offset_bytes > count * sizeof(f32)){
+            return std::unexpected{ device_error::launch_failed };
+        }
+
+        auto data_res = host_kernel_launcher.random_mat_binary_f32_1d(data_domain::full_range, 1u, count, 5519u);
+        if(!data_res.has_value()) { 
+            return std::unexpected{data_res.error()}; 
+        }
+        data = data_res.value();
+
+        result = ctx.init(version<u32>{0, 1, 2, 0}, gen_app_name(count, offset_bytes));
+        if(!result.has_value()) { 
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        result = ctx.set_device(device_select::first_compute_capable);
+        if(!result.has_value()) { 
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        auto device_limits_res = ctx.limits();
+        if (!device_limits_res.has_value()){
+            ctx.exit();
+            return std::unexpected{device_limits_res.error()}; 
+        }
+        if (!device_limits_res.value().buffer_device_address){
+            ctx.exit();
+            return std::unexpected{device_error::not_available}; 
+        }
+
+        auto d_buff_ref_res = ctx.allocate(count * sizeof(f32), alloc_method::base);
+        auto d_buff_bda_res = ctx.allocate(count * sizeof(f32), alloc_method::device_local);
+        if(!d_buff_ref_res.has_value() || !d_buff_bda_res.has_value()) { 
+            ctx.exit();
+            return std::unexpected{device_error::alloc_failed}; 
+        }
+        auto d_buff_ref = d_buff_ref_res.value();
+        auto d_buff_bda = d_buff_bda_res.value();
+
+        result = ctx.upload(d_buff_ref, std::span<f32>{data}, upload_method::sync);
+        if(result.has_value()) result = ctx.upload(d_buff_bda, std::span<f32>{data}, upload_method::sync);
+        if(!result.has_value()) { 
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        algorithm<
+            device_driver::vulkan_native, 
+            execution_method::sequenced
+        > device_kernel_launcher(ctx, config);
+
+        result = device_kernel_launcher.multiply(work_group_size, d_buff_ref, mull_factor);
+        if(result.has_value()) result = device_kernel_launcher.multiply_bda(work_group_size, d_buff_bda, mull_factor, offset_bytes);
+        if(result.has_value()) result = ctx.wait_for_last_kernel(1'000'000'000ull);
+        if(!result.has_value()) { 
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        ref.resize(count);
+        out.resize(count);
+        result = ctx.download(std::span<f32>{ref}, d_buff_ref, download_method::sync);
+        if(result.has_value()) result = ctx.download(std::span<f32>{out}, d_buff_bda, download_method::sync);
+        if (!result.has_value()){
+            ctx.exit();
+            return std::unexpected{result.error()}; 
+        }
+
+        ctx.exit();
+
+        // A single f32 multiply is correctly rounded on the device as well, the results are exact
+        const usize head = offset_bytes / sizeof(f32);
+        f32 max_abs_err = 0.0f;
+        usize mismatches = 0;
+        for (usize i=0; i<count; ++i){ 
+            const f32 scaled = data[i] * mull_factor;
+            const f32 expected = i < head ? data[i] : scaled;
+            f32 e = std::max(std::abs(ref[i] - scaled), std::abs(out[i] - expected));
+            if (e > max_abs_err) max_abs_err=e; 
+            if (e != 0.0f) ++mismatches; 
+        }
+
+        return sandbox_results<sandbox_algorithm::mull>{max_abs_err, mismatches, count};
+    };
+
+private:
+    static constexpr vec3<u32> work_group_size{64u, 1u, 1u};
+
+    application_config config;
+    std::expected<void, device_error> result;
+    std::filesystem::path rsc = RESOURCE_DIR;
+    compute_context<device_driver::vulkan_native> ctx;
+    algorithm<device_driver::cpu_native, execution_method::standalone> host_kernel_launcher;
+
+    std::vector<f32> data;
+    std::vector<f32> ref;
+    std::vector<f32> out;
+
+    auto gen_app_name(u32 count, usize offset_bytes) -> str {
+        return 
+            to_string(sandbox_algorithm::mull) + "_bda_" +
+            std::to_string(count) + "+" +
+            std::to_string(offset_bytes) + "B";
+    };
+
+};
+
+#endif // TARGET_VULKAN_NATIVE
+
+// Checks every cpu_native variant supported on this machine against the scalar reference
+template<> struct sandbox<sandbox_algorithm::binmatmul, device_driver::cpu_native> {
+
+    auto run(
+        data_domain domain,
+        u32 M, 
+        u32 N,
+        u32 K_bits
+    ) -> std::expected<sandbox_results<sandbox_algorithm::binmatmul>, device_error> {
+
+        auto A_res = host_kernel_launcher.random_mat_binary_f32_1d(domain, M, K_bits, 7937929);
+        if(!A_res.has_value()) { 
+            return std::unexpected{A_res.error()}; 
+        }
+        A = A_res.value();
+
+        auto B_res = host_kernel_launcher.random_mat_binary_f32_1d(domain, K_bits, N, 732973980);
+        if(!B_res.has_value()) { 
+            return std::unexpected{B_res.error()}; 
+        }
+        B = B_res.value();
+
+        auto A_bits_res = host_kernel_launcher.f32_mat_to_packed_u32(matrix_order::row_major, A, M, K_bits);
+        if(!A_bits_res.has_value()) { 
+            return std::unexpected{A_bits_res.error()}; 
+        }
+        A_bits = A_bits_res.value();
+
+        auto B_bits_res = host_kernel_launcher.f32_mat_to_packed_u32(matrix_order::col_major, B, N, K_bits);
+        if(!B_bits_res.has_value()) { 
+            return std::unexpected{B_bits_res.error()}; 
+        }
+        B_bits = B_bits_res.value();
+
+        auto C_ref_res = host_kernel_launcher.binmatmul(A_bits, B_bits, M, N, K_bits, cpu_isa::scalar);
+        if(!C_ref_res.has_value()) { 
+            return std::unexpected{C_ref_res.error()}; 
+        }
+        C_ref = C_ref_res.value();
+
+        host_kernel_launcher.set_thread_count(3);
+
+        i32 max_abs_err = 0; 
+        usize mismatches = 0;
+
+        // Every vectorized packer has to reproduce the per-element reference packers bit for bit
+        auto A_bits_ref = f32_mat_to_packed_u32_row_major_cpu_native_standalone(A, M, K_bits);
+        auto B_bits_ref = f32_mat_to_packed_u32_col_major_cpu_native_standalone(B, N, K_bits);
+        if(!A_bits_ref.has_value()) { 
+            return std::unexpected{A_bits_ref.error()}; 
+        }
+        if(!B_bits_ref.has_value()) { 
+            return std::unexpected{B_bits_ref.error()}; 
+        }
+
+        for (auto isa : supported_cpu_isas()){
+            auto A_pack = host_kernel_launcher.f32_mat_to_packed_u32(matrix_order::row_major, A, M, K_bits, isa);
+            auto B_pack = host_kernel_launcher.f32_mat_to_packed_u32(matrix_order::col_major, B, N, K_bits, isa);
+            if(!A_pack.has_value()) { 
+                return std::unexpected{A_pack.error()}; 
+            }
+            if(!B_pack.has_value()) { 
+                return std::unexpected{B_pack.error()}; 
+            }
+            if (A_pack.value() != A_bits_ref.value()) ++mismatches;
+            if (B_pack.value() != B_bits_ref.value()) ++mismatches;
+        }
+
+        auto compare = [&](const std::vector<i32>& C){
+            for (usize i=0; i<C.size(); ++i){ 
+                i32 e = std::abs(C[i] - C_ref[i]); 
+                if (e > max_abs_err) max_abs_err=e; 
+                if (e != 0) ++mismatches; 
+            }
+        };
+
+        for (auto isa : supported_cpu_isas()){
+            if (isa != cpu_isa::scalar) {
+                auto C_res = host_kernel_launcher.binmatmul(A_bits, B_bits, M, N, K_bits, isa);
+                if(!C_res.has_value()) { 
+                    return std::unexpected{C_res.error()}; 
+                }
+                compare(C_res.value());
+            }
+
+            // Default blocking plus a tiny one that forces partial panels and several K blocks
+            for (auto blocking : {cpu_gemm_blocking{}, cpu_gemm_blocking{8u, 12u, 3u}}){
+                auto C_res = host_kernel_launcher.binmatmul_blocked(A_bits, B_bits, M, N, K_bits, blocking, isa);
+                if(!C_res.has_value()) { 
+                    return std::unexpected{C_res.error()}; 
+                }
+                compare(C_res.value());
+            }
+
+            // Odd thread count and tiles that leave ragged edges on both axes. The tiled engine is called
+            // directly, the algorithm method hands small M to the GEMV path which is checked below.
+            for (auto tile_size : {vec2<u32>{128u, 32u}, vec2<u32>{5u, 3u}}){
+                auto C_res = binmatmul_parallel_cpu_native_standalone(
+                    host_kernel_launcher.thread_pool(), A_bits, B_bits, M, N, K_bits, tile_size, isa);
+                if(!C_res.has_value()) { 
+                    return std::unexpected{C_res.error()}; 
+                }
+                compare(C_res.value());
+            }
+
+            // GEMV path at every M, not only the decode shapes it is selected for
+            auto C_gemv_res = host_kernel_launcher.binmatmul_gemv(A_bits, B_bits, M, N, K_bits, isa);
+            if(!C_gemv_res.has_value()) { 
+                return std::unexpected{C_gemv_res.error()}; 
+            }
+            compare(C_gemv_res.value());
+        }
+
+        return sandbox_results<sandbox_algorithm::binmatmul>{max_abs_err, mismatches, C_ref.size()};
     };
 
+private:
+    algorithm<device_driver::cpu_native, execution_method::standalone> host_kernel_launcher;
 
+    std::vector<f32> A;
+    std::vector<f32> B;
+    std::vector<u32> A_bits;
+    std::vector<u32> B_bits;
+    std::vector<i32> C_ref;
 
 };
 
+// Checks the packed ternary kernels against an unpacked f32 GEMM of the same inputs
+template<> struct sandbox<sandbox_algorithm::ternmatmul, device_driver::cpu_native> {
+
+    auto run(
+        data_domain domain,
+        u32 M, 
+        u32 N,
+        u32 K_bits
+    ) -> std::expected<sandbox_results<sandbox_algorithm::ternmatmul>, device_error> {
+
+        auto A_res = host_kernel_launcher.random_mat_binary_f32_1d(domain, M, K_bits, 7937929);
+        if(!A_res.has_value()) { 
+            return std::unexpected{A_res.error()}; 
+        }
+        A = A_res.value();
+
+        auto B_res = host_kernel_launcher.random_mat_binary_f32_1d(domain, K_bits, N, 732973980);
+        if(!B_res.has_value()) { 
+            return std::unexpected{B_res.error()}; 
+        }
+        B = B_res.value();
+
+        auto A_planes_res = host_kernel_launcher.f32_mat_to_packed_ternary_u32(matrix_order::row_major, A, M, K_bits);
+        if(!A_planes_res.has_value()) { 
+            return std::unexpected{A_planes_res.error()}; 
+        }
+        A_planes = A_planes_res.value();
+
+        auto B_planes_res = host_kernel_launcher.f32_mat_to_packed_ternary_u32(matrix_order::col_major, B, N, K_bits);
+        if(!B_planes_res.has_value()) { 
+            return std::unexpected{B_planes_res.error()}; 
+        }
+        B_planes = B_planes_res.value();
+
+        auto C_ref_res = host_kernel_launcher.ternmatmul_reference(A, B, M, N, K_bits);
+        if(!C_ref_res.has_value()) { 
+            return std::unexpected{C_ref_res.error()}; 
+        }
+        C_ref = C_ref_res.value();
+
+        i32 max_abs_err = 0; 
+        usize mismatches = 0;
+
+        for (auto isa : supported_cpu_isas()){
+            auto C_res = host_kernel_launcher.ternmatmul(A_planes, B_planes, M, N, K_bits, isa);
+            if(!C_res.has_value()) { 
+                return std::unexpected{C_res.error()}; 
+            }
+
+            const auto& C = C_res.value();
+            for (usize i=0; i<C.size(); ++i){ 
+                i32 e = std::abs(C[i] - C_ref[i]); 
+                if (e > max_abs_err) max_abs_err=e; 
+                if (e != 0) ++mismatches; 
+            }
+        }
+
+        return sandbox_results<sandbox_algorithm::ternmatmul>{max_abs_err, mismatches, C_ref.size()};
+    };
+
+private:
+    algorithm<device_driver::cpu_native, execution_method::standalone> host_kernel_launcher;
+
+    std::vector<f32> A;
+    std::vector<f32> B;
+    std::vector<u32> A_planes;
+    std::vector<u32> B_planes;
+    std::vector<i32> C_ref;
+
+};
+
+// Runs sandbox<A, cpu_native> on every data domain for each M in m_values (N = M + 3, so C is never square) and
+// each K in k_values. Failing cases and a summary per domain are reported under [<algorithm>_cpu].
+// True when every case matched its reference.
+template<sandbox_algorithm A>
+auto run_cpu_sandbox_sweep(std::span<const u32> m_values, std::span<const u32> k_values) -> bool {
+    const str tag = "[" + to_string(A) + "_cpu] ";
+
+    std::cout << tag << "variants:";
+    for (auto isa : supported_cpu_isas()) std::cout << " " << to_string(isa);
+    std::cout << "\n";
+
+    bool all_passed = true;
+    usize total_cases = 0;
+
+    for (auto domain : {data_domain::full_range, data_domain::pm_one, data_domain::zero_one, data_domain::trinary}) {
+        bool domain_passed = true;
+        usize domain_cases = 0;
+
+        for (auto M : m_values) {
+            const u32 N = M + 3u;
+
+            for (auto K_bits : k_values) {
+                domain_cases++;
+                total_cases++;
+
+                const str case_label = to_string(domain) + "_" +
+                                       std::to_string(M) + "x" + std::to_string(N) + "_" +
+                                       std::to_string(K_bits) + "bit";
+
+                sandbox<A, device_driver::cpu_native> bench;
+                auto result = bench.run(domain, M, N, K_bits);
+                bool ok = result.has_value();
+                if (!ok) {
+                    std::cerr << tag << case_label << " failed: " << result.error() << "\n";
+                } else if (result.value().total_size != static_cast<usize>(M) * N) {
+                    std::cerr << tag << case_label
+                              << " unexpected total_size=" << result.value().total_size
+                              << " (expected " << static_cast<usize>(M) * N << ")\n";
+                    ok = false;
+                } else if (result.value().mismatches != 0 || result.value().max_abs_err != 0) {
+                    std::cerr << tag << case_label
+                              << " mismatches=" << result.value().mismatches
+                              << " max_abs_err=" << result.value().max_abs_err << "\n";
+                    ok = false;
+                }
+
+                domain_passed = ok && domain_passed;
+                all_passed = ok && all_passed;
+            }
+        }
+
+        if (domain_passed) {
+            std::cout << tag << "domain=" << to_string(domain)
+                      << " all cases passed (" << domain_cases << ")\n";
+        } else {
+            std::cerr << tag << "domain=" << to_string(domain)
+                      << " detected failures (" << domain_cases << " total cases)\n";
+        }
+    }
+
+    if (all_passed) {
+        std::cout << tag << "completed " << total_cases << " combinations without error\n";
+    } else {
+        std::cerr << tag << "regression detected across " << total_cases << " combinations\n";
+    }
+
+    return all_passed;
+}
 
 } // tether_io
\ No newline at end of file
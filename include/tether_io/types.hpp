@@ -60,6 +60,10 @@ struct device_driver_impl;
 template<device_driver D>
 struct device_buffer;
 
+// Waitable handle of an upload_method::async / download_method::async transfer
+template<device_driver D>
+struct transfer;
+
 enum class data_domain   : u8 { full_range, pm_one, zero_one, trinary };
 enum class matrix_order   : u8 { row_major, col_major };
 
@@ -73,8 +77,45 @@ inline std::string to_string(data_domain domain) {
     }
 }
 
+// Instruction sets the cpu_native kernels can be dispatched to
+enum class cpu_isa : u8 { scalar, avx2, avx512_vpopcntdq, neon };
+
+inline std::string to_string(cpu_isa isa) {
+    switch (isa) {
+        case cpu_isa::scalar:           return "scalar";
+        case cpu_isa::avx2:             return "avx2";
+        case cpu_isa::avx512_vpopcntdq: return "avx512_vpopcntdq";
+        case cpu_isa::neon:             return "neon";
+        default: return "unkown_isa";
+    }
+}
+
+// Cache blocking of the packed cpu_native GEMM engine, K is counted in 64-bit words.
+// Rough sizing: one MR/NR micro-panel of kc words in L1, mc x kc of A in L2, nc x kc of B in L3.
+struct cpu_gemm_blocking {
+    u32 mc { 64 };
+    u32 nc { 2048 };
+    u32 kc { 512 };
+};
+
+// Up to this many rows of A (tokens in flight during decode) binmatmul takes the GEMV kernels, which
+// stream B once and reduce K cooperatively instead of tiling C in 2D.
+inline constexpr u32 binmatmul_gemv_max_rows = 4u;
+
+// Columns (x) and rows (y) of C one invocation of binmatmul_microtile computes, specialization constants 4 and 3
+inline constexpr vec2<u32> binmatmul_micro_tile{ 4u, 4u };
+
+// Long-K shapes with few elements of C past the GEMV rows (K_bits >= binmatmul_subgroup_min_k_bits, M * N <= binmatmul_subgroup_max_outputs)
+// take the subgroup kernel, one subgroup per element of C, on devices with subgroup arithmetic in compute shaders.
+inline constexpr u32 binmatmul_subgroup_min_k_bits = 4096u;
+inline constexpr u64 binmatmul_subgroup_max_outputs = 16384u;
+
 // Exection methods
-enum class alloc_method { base, custom };
+// base: host-visible coherent memory, mapped directly on upload/download.
+// device_local: device memory (VRAM on discrete GPUs) filled through a staging buffer and vkCmdCopyBuffer,
+// on unified-memory devices it falls back to device-local host-visible memory and skips the staging copy.
+// custom: device_local memory sub-allocated from large pooled blocks, returned to the pool by free().
+enum class alloc_method { base, device_local, custom };
 enum class upload_method { sync, async };
 enum class download_method { sync, async };
 enum class execution_method { standalone, sequenced };
@@ -82,14 +123,26 @@ enum class execution_method { standalone, sequenced };
 // Kernel types
 enum class kernel_type : u8 { vulkan_compute_shader /* future: CUDA, Metal */ };
 enum class kernel_format : u8 { glsl, spirv, hlsl };
+// descriptors: buffers are bound as storage-buffer descriptors (set 0, binding i)
+// buffer_address: buffers are passed as device addresses inside the push constants (GL_EXT_buffer_reference)
+enum class binding_model : u8 { descriptors, buffer_address };
 enum class launch_method : u8 { sync, async, interrupt };
 
+// How a dispatch uses each bound buffer, recorded sequences derive their barriers from it
+enum class buffer_access : u8 { read, write, read_write };
+
+struct sequence_stats {
+    usize dispatches{};
+    usize barriers{};   // vkCmdPipelineBarrier calls inserted between dispatches
+};
+
 // Sanbox
-enum class sandbox_algorithm : u8 { binmatmul, mull, fill };
+enum class sandbox_algorithm : u8 { binmatmul, ternmatmul, mull, fill };
 
 inline std::string to_string(sandbox_algorithm algo) {
     switch (algo) {
         case sandbox_algorithm::binmatmul: return "binmatmul";
+        case sandbox_algorithm::ternmatmul: return "ternmatmul";
         case sandbox_algorithm::mull: return "mull";
         case sandbox_algorithm::fill: return "fill";
         default: return "unkown_algo";
@@ -105,6 +158,24 @@ template<> struct sandbox_results<sandbox_algorithm::binmatmul>{
     usize total_size;
 };
 
+template<> struct sandbox_results<sandbox_algorithm::ternmatmul>{
+    i32 max_abs_err; 
+    usize mismatches;
+    usize total_size;
+};
+
+template<> struct sandbox_results<sandbox_algorithm::fill>{
+    f32 max_abs_err; 
+    usize mismatches;
+    usize total_size;
+};
+
+template<> struct sandbox_results<sandbox_algorithm::mull>{
+    f32 max_abs_err; 
+    usize mismatches;
+    usize total_size;
+};
+
 struct kernel_config {
     str name;
     bool recompile;
@@ -112,6 +183,7 @@ struct kernel_config {
     kernel_format format;
     version<u32> type_version;
     usize param_size_bytes; 
+    binding_model binding{ binding_model::descriptors };
     std::filesystem::path path;
     std::filesystem::path path_bin;
 };
@@ -119,14 +191,35 @@ struct kernel_config {
 template<device_driver D>
 struct kernel;
 
+// Completion token of an async kernel launch
+template<device_driver D>
+struct launch_token;
+
+// Recorded sequence of dispatches, replayed with one submission
+template<device_driver D>
+struct command_graph;
+
 // Configuration setting for whole application
 struct application_config {
     std::filesystem::path resource_dir;
     std::filesystem::path kernel_dir;
     kernel_format kernel_bin_format { kernel_format::spirv };
     std::unordered_map<str, kernel_config> kernels;
+    std::unordered_map<str, str> variants; // algorithm -> kernel it launches, from the "variants" object of index.json
 };
 
+// Name of the kernel an algorithm launches: its index.json variant if one is selected, the algorithm's own kernel otherwise
+inline auto kernel_variant(const application_config& cfg, const str& algorithm) -> str {
+    auto it = cfg.variants.find(algorithm);
+    return it == cfg.variants.end() ? algorithm : it->second;
+}
+
+// Block of C one invocation of the selected "binmatmul" variant computes: binmatmul_micro_tile for binmatmul_microtile,
+// a single element otherwise. The 2D grid is sized in units of it.
+inline auto binmatmul_variant_tile(const application_config& cfg) -> vec2<u32> {
+    return kernel_variant(cfg, "binmatmul") == "binmatmul_microtile" ? binmatmul_micro_tile : vec2<u32>{1u, 1u};
+}
+
 // Error types
 enum class json_error : u8 {
     invalid_json_format, key_not_found, invalid_value_type
@@ -157,10 +250,41 @@ enum class device_error : u8 {
     could_not_register_kernel,
     could_not_dispatch_kernel_to_command_buffer,
     kernel_timout_reached,
+    buffer_not_mappable,
+    transfer_timeout_reached,
+};
+
+// Subgroup operation classes usable from compute shaders (GL_KHR_shader_subgroup_*)
+struct subgroup_ops {
+    bool basic{false};
+    bool vote{false};
+    bool arithmetic{false};
+    bool ballot{false};
+    bool shuffle{false};
+    bool shuffle_relative{false};
+    bool clustered{false};
+    bool quad{false};
 };
 
 struct device_limits {
     vec3<u32> max_compute_work_group_size{1u, 1u, 1u};
+    bool unified_memory{false}; // integrated / CPU device, device_local buffers are host visible
+    bool async_transfers{false};          // timeline semaphores available, async uploads/downloads do not block
+    bool dedicated_transfer_queue{false}; // async transfers run on a transfer-only queue family
+    bool push_descriptors{false};         // VK_KHR_push_descriptor, buffer bindings are written into the command buffer
+    bool buffer_device_address{false};    // binding_model::buffer_address kernels can be registered
+    u32 subgroup_size{0u};                // invocations per subgroup, 0 when the device reports no compute subgroups
+    subgroup_ops subgroup;                // operations compute shaders can use on them
+};
+
+// Sub-allocating pool behind alloc_method::custom
+struct memory_pool_stats {
+    usize block_count{};      // device memory blocks held by the pool
+    usize reserved_bytes{};   // sum of the block sizes
+    usize in_use_bytes{};     // live sub-allocations, rounded to their power-of-two size
+    usize requested_bytes{};  // live sub-allocations as requested
+    usize allocation_count{};
+    f64 fragmentation{};      // 1 - largest free block / free bytes (0: all free memory is one block)
 };
 
 std::ostream& operator<<(std::ostream& os, const json_error& error) {
@@ -243,6 +367,12 @@ std::ostream& operator<<(std::ostream& os, const device_error& error) {
         case device_error::kernel_timout_reached : 
             os << "Timeout reached, kernel is not responding complete status";
             break; 
+        case device_error::buffer_not_mappable : 
+            os << "Buffer lives in device-local memory the host cannot map";
+            break; 
+        case device_error::transfer_timeout_reached : 
+            os << "Timeout reached, asynchronous transfer has not completed";
+            break; 
         default:
             os << "Unkown error with device";
             break;
@@ -267,6 +397,7 @@ std::ostream& operator<<(std::ostream& os, const kernel_config& cfg){
         << "\t - type = " << (cfg.type == kernel_type::vulkan_compute_shader ? "vulkan_compute_shader" : "unknown") << std::endl
         << "\t - format = " << (cfg.format == kernel_format::glsl ? "glsl" : "unknown") << std::endl
         << "\t - type_version = " << cfg.type_version << std::endl
+        << "\t - binding_model = " << (cfg.binding == binding_model::buffer_address ? "buffer_address" : "descriptors") << std::endl
         << "\t - path = " << cfg.path << std::endl
         << "\t - path_bin = " << cfg.path_bin << std::endl;
     
@@ -0,0 +1,63 @@
+#version 450
+#extension GL_EXT_buffer_reference : require
+
+// binmatmul.comp.glsl with buffer_address binding: A, B and C are device addresses in the push
+// constants instead of descriptors, so the same pipeline can run on any buffer or offset into one.
+
+layout(constant_id = 0) const uint LOCAL_SIZE_X = 8;
+layout(constant_id = 1) const uint LOCAL_SIZE_Y = 8;
+layout(constant_id = 2) const uint LOCAL_SIZE_Z = 1;
+layout(local_size_x_id = 0, local_size_y_id = 1, local_size_z_id = 2) in;
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer Bits { uint bits[]; };
+layout(buffer_reference, std430, buffer_reference_align = 4) writeonly buffer Dots { int dots[]; };
+
+layout(push_constant) uniform PushConsts {
+    Bits A;
+    Bits B;
+    Dots C;
+    uint M;
+    uint N;
+    uint K_bits;
+    uint K_words;
+} pc;
+
+void main() {
+    uint row = gl_GlobalInvocationID.y;
+    uint col = gl_GlobalInvocationID.x;
+
+    if (row >= pc.M || col >= pc.N)
+        return;
+
+    uint cIndex = row * pc.N + col;
+
+    // Early out for degenerate case
+    if (pc.K_words == 0u || pc.K_bits == 0u) {
+        pc.C.dots[cIndex] = 0;
+        return;
+    }
+
+    uint baseA = row * pc.K_words;
+    uint baseB = col * pc.K_words;
+
+    uint lastKw   = pc.K_words - 1u;
+    uint tailBits = pc.K_bits & 31u;
+    uint tailMask = (tailBits == 0u)
+        ? 0xFFFFFFFFu
+        : ((1u << tailBits) - 1u);
+
+    uint matches = 0u;
+
+    // Main loop over all full words except the last one
+    for (uint kw = 0u; kw < lastKw; ++kw) {
+        uint a = pc.A.bits[baseA + kw];
+        uint b = pc.B.bits[baseB + kw];
+        matches += bitCount(~(a ^ b));
+    }
+
+    // Last word, with tail mask (or full mask if no tail)
+    uint xnorLast = ~(pc.A.bits[baseA + lastKw] ^ pc.B.bits[baseB + lastKw]);
+    matches += bitCount(xnorLast & tailMask);
+
+    pc.C.dots[cIndex] = int(matches) * 2 - int(pc.K_bits);
+}
@@ -0,0 +1,67 @@
+#version 450
+
+// GEMV-shaped binmatmul for decode (M of a few tokens). Instead of one invocation per C element, the
+// LOCAL_SIZE_X invocations of a workgroup row share one dot product: they stride over K_words with
+// consecutive words (coalesced B reads) and combine their partial counts with a shared-memory tree.
+// Each workgroup covers LOCAL_SIZE_Y columns of one row of C, so no invocation idles on the M bound.
+// LOCAL_SIZE_X has to be a power of two.
+layout(constant_id = 0) const uint LOCAL_SIZE_X = 32;
+layout(constant_id = 1) const uint LOCAL_SIZE_Y = 4;
+layout(constant_id = 2) const uint LOCAL_SIZE_Z = 1;
+layout(local_size_x_id = 0, local_size_y_id = 1, local_size_z_id = 2) in;
+
+layout(set = 0, binding = 0) readonly buffer A_buf { uint A_bits[]; };
+layout(set = 0, binding = 1) readonly buffer B_buf { uint B_bits[]; };
+layout(set = 0, binding = 2) writeonly buffer C_buf { int C_out[]; };
+
+layout(push_constant) uniform PushConsts {
+    uint M;
+    uint N;
+    uint K_bits;
+    uint K_words;
+} pc;
+
+shared uint partial[LOCAL_SIZE_X * LOCAL_SIZE_Y];
+
+void main() {
+    uint lane = gl_LocalInvocationID.x;
+    uint slot = gl_LocalInvocationID.y;
+    uint col  = gl_WorkGroupID.x * LOCAL_SIZE_Y + slot;
+    uint row  = gl_WorkGroupID.y;
+
+    // No early return: every invocation has to reach the barriers below
+    bool active = row < pc.M && col < pc.N;
+
+    uint matches = 0u;
+    if (active && pc.K_words != 0u) {
+        uint baseA = row * pc.K_words;
+        uint baseB = col * pc.K_words;
+
+        uint lastKw   = pc.K_words - 1u;
+        uint tailBits = pc.K_bits & 31u;
+        uint tailMask = (tailBits == 0u)
+            ? 0xFFFFFFFFu
+            : ((1u << tailBits) - 1u);
+
+        for (uint kw = lane; kw < pc.K_words; kw += LOCAL_SIZE_X) {
+            uint xnor = ~(A_bits[baseA + kw] ^ B_bits[baseB + kw]);
+            if (kw == lastKw) xnor &= tailMask;
+            matches += bitCount(xnor);
+        }
+    }
+
+    uint base = slot * LOCAL_SIZE_X;
+    partial[base + lane] = matches;
+    barrier();
+
+    for (uint stride = LOCAL_SIZE_X / 2u; stride > 0u; stride >>= 1u) {
+        if (lane < stride) {
+            partial[base + lane] += partial[base + lane + stride];
+        }
+        barrier();
+    }
+
+    if (active && lane == 0u) {
+        C_out[row * pc.N + col] = int(partial[base]) * 2 - int(pc.K_bits);
+    }
+}
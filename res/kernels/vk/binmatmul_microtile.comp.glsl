@@ -0,0 +1,97 @@
+#version 450
+
+layout(constant_id = 0) const uint LOCAL_SIZE_X = 16;
+layout(constant_id = 1) const uint LOCAL_SIZE_Y = 16;
+layout(constant_id = 2) const uint LOCAL_SIZE_Z = 1;
+// Rows and columns of C computed by one invocation
+layout(constant_id = 3) const uint TILE_M = 4;
+layout(constant_id = 4) const uint TILE_N = 4;
+layout(local_size_x_id = 0, local_size_y_id = 1, local_size_z_id = 2) in;
+
+// A and B are also viewed as uvec4 for 16-byte loads along K, taken when K_words is a multiple of 4
+layout(set = 0, binding = 0) readonly buffer A_buf { uint A_bits[]; };
+layout(set = 0, binding = 0) readonly buffer A_vec_buf { uvec4 A_vec[]; };
+layout(set = 0, binding = 1) readonly buffer B_buf { uint B_bits[]; };
+layout(set = 0, binding = 1) readonly buffer B_vec_buf { uvec4 B_vec[]; };
+layout(set = 0, binding = 2) writeonly buffer C_buf { int C_out[]; };
+
+layout(push_constant) uniform PushConsts {
+    uint M;
+    uint N;
+    uint K_bits;
+    uint K_words;
+} pc;
+
+uint matches4(uvec4 a, uvec4 b) {
+    ivec4 c = bitCount(~(a ^ b));
+    return uint(c.x + c.y + c.z + c.w);
+}
+
+void main() {
+    uint rowBase = gl_GlobalInvocationID.y * TILE_M;
+    uint colBase = gl_GlobalInvocationID.x * TILE_N;
+
+    if (rowBase >= pc.M || colBase >= pc.N)
+        return;
+
+    // Rows / columns past the edge of C are clamped onto the last one, so loads stay in bounds.
+    // Their results are not stored.
+    uint aBase[TILE_M];
+    uint bBase[TILE_N];
+    for (uint i = 0u; i < TILE_M; ++i) aBase[i] = min(rowBase + i, pc.M - 1u) * pc.K_words;
+    for (uint j = 0u; j < TILE_N; ++j) bBase[j] = min(colBase + j, pc.N - 1u) * pc.K_words;
+
+    uint acc[TILE_M * TILE_N];
+    for (uint t = 0u; t < TILE_M * TILE_N; ++t) acc[t] = 0u;
+
+    uint tailBits = pc.K_bits & 31u;
+    uint tailMask = (tailBits == 0u)
+        ? 0xFFFFFFFFu
+        : ((1u << tailBits) - 1u);
+
+    // Each loaded word of A is reused for TILE_N columns and each word of B for TILE_M rows. Bits past
+    // K_bits are cleared in A and set in B, their XNOR is 0 and adds no matches.
+    if ((pc.K_words & 3u) == 0u) {
+        uint kVecs = pc.K_words >> 2u;
+        for (uint kv = 0u; kv < kVecs; ++kv) {
+            uvec4 mask = (kv + 1u == kVecs)
+                ? uvec4(0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, tailMask)
+                : uvec4(0xFFFFFFFFu);
+
+            uvec4 a[TILE_M];
+            uvec4 b[TILE_N];
+            for (uint i = 0u; i < TILE_M; ++i) a[i] = A_vec[(aBase[i] >> 2u) + kv] & mask;
+            for (uint j = 0u; j < TILE_N; ++j) b[j] = B_vec[(bBase[j] >> 2u) + kv] | ~mask;
+
+            for (uint i = 0u; i < TILE_M; ++i)
+                for (uint j = 0u; j < TILE_N; ++j)
+                    acc[i * TILE_N + j] += matches4(a[i], b[j]);
+        }
+    } else {
+        // Rows are not 16-byte aligned, same blocking with 32-bit loads
+        uint lastKw = pc.K_words - 1u;
+        for (uint kw = 0u; kw < pc.K_words; ++kw) {
+            uint mask = (kw == lastKw) ? tailMask : 0xFFFFFFFFu;
+
+            uint a[TILE_M];
+            uint b[TILE_N];
+            for (uint i = 0u; i < TILE_M; ++i) a[i] = A_bits[aBase[i] + kw] & mask;
+            for (uint j = 0u; j < TILE_N; ++j) b[j] = B_bits[bBase[j] + kw] | ~mask;
+
+            for (uint i = 0u; i < TILE_M; ++i)
+                for (uint j = 0u; j < TILE_N; ++j)
+                    acc[i * TILE_N + j] += uint(bitCount(~(a[i] ^ b[j])));
+        }
+    }
+
+    for (uint i = 0u; i < TILE_M; ++i) {
+        uint row = rowBase + i;
+        if (row >= pc.M) break;
+        for (uint j = 0u; j < TILE_N; ++j) {
+            uint col = colBase + j;
+            if (col >= pc.N) break;
+            // Degenerate K gives 0, like binmatmul.comp.glsl
+            C_out[row * pc.N + col] = (pc.K_words == 0u) ? 0 : int(acc[i * TILE_N + j]) * 2 - int(pc.K_bits);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#version 450
+#extension GL_KHR_shader_subgroup_basic : require
+#extension GL_KHR_shader_subgroup_arithmetic : require
+
+// Long-K binmatmul for shapes with few elements of C: each element gets a whole subgroup, whose lanes
+// stride over K_words with consecutive words (coalesced reads) and combine their popcounts with one
+// subgroupAdd, no shared memory or barriers. A workgroup covers COLS columns of one row of C.
+layout(constant_id = 0) const uint LOCAL_SIZE_X = 128;
+layout(constant_id = 1) const uint LOCAL_SIZE_Y = 1;
+layout(constant_id = 2) const uint LOCAL_SIZE_Z = 1;
+// Columns per workgroup, LOCAL_SIZE_X / the subgroup size device_limits reports
+layout(constant_id = 3) const uint COLS = 4;
+layout(local_size_x_id = 0, local_size_y_id = 1, local_size_z_id = 2) in;
+
+layout(set = 0, binding = 0) readonly buffer A_buf { uint A_bits[]; };
+layout(set = 0, binding = 1) readonly buffer B_buf { uint B_bits[]; };
+layout(set = 0, binding = 2) writeonly buffer C_buf { int C_out[]; };
+
+layout(push_constant) uniform PushConsts {
+    uint M;
+    uint N;
+    uint K_bits;
+    uint K_words;
+} pc;
+
+void main() {
+    uint row  = gl_WorkGroupID.y;
+    uint lane = gl_SubgroupInvocationID;
+    // Active lanes of this subgroup, fewer than gl_SubgroupSize when LOCAL_SIZE_X is not a multiple of it
+    uint lanes = subgroupAdd(1u);
+
+    uint lastKw   = pc.K_words - 1u;
+    uint tailBits = pc.K_bits & 31u;
+    uint tailMask = (tailBits == 0u)
+        ? 0xFFFFFFFFu
+        : ((1u << tailBits) - 1u);
+
+    // The loop also covers a driver picking another subgroup size than the reported one
+    for (uint e = gl_SubgroupID; e < COLS; e += gl_NumSubgroups) {
+        uint col = gl_WorkGroupID.x * COLS + e;
+
+        // row and col are uniform across the subgroup, so subgroupAdd below sees all of its lanes
+        if (row >= pc.M || col >= pc.N)
+            continue;
+
+        uint baseA = row * pc.K_words;
+        uint baseB = col * pc.K_words;
+
+        uint matches = 0u;
+        for (uint kw = lane; kw < pc.K_words; kw += lanes) {
+            uint xnor = ~(A_bits[baseA + kw] ^ B_bits[baseB + kw]);
+            if (kw == lastKw) xnor &= tailMask;
+            matches += bitCount(xnor);
+        }
+
+        uint total = subgroupAdd(matches);
+        if (subgroupElect()) {
+            // Degenerate K gives 0, like binmatmul.comp.glsl
+            C_out[row * pc.N + col] = (pc.K_words == 0u) ? 0 : int(total) * 2 - int(pc.K_bits);
+        }
+    }
+}
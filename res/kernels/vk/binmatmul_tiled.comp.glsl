@@ -0,0 +1,90 @@
+#version 450
+
+layout(constant_id = 0) const uint LOCAL_SIZE_X = 16;
+layout(constant_id = 1) const uint LOCAL_SIZE_Y = 16;
+layout(constant_id = 2) const uint LOCAL_SIZE_Z = 1;
+// 32-bit words of K staged in shared memory per round
+layout(constant_id = 3) const uint K_TILE = 32;
+layout(local_size_x_id = 0, local_size_y_id = 1, local_size_z_id = 2) in;
+
+layout(set = 0, binding = 0) readonly buffer A_buf { uint A_bits[]; };
+layout(set = 0, binding = 1) readonly buffer B_buf { uint B_bits[]; };
+layout(set = 0, binding = 2) writeonly buffer C_buf { int C_out[]; };
+
+layout(push_constant) uniform PushConsts {
+    uint M;
+    uint N;
+    uint K_bits;
+    uint K_words;
+} pc;
+
+// One K chunk of the workgroup's LOCAL_SIZE_Y rows of A and LOCAL_SIZE_X columns of B. The padded
+// stride keeps the Bs reads of neighbouring invocations (one column each) on different banks.
+const uint TILE_STRIDE = K_TILE + 1u;
+shared uint As[LOCAL_SIZE_Y * TILE_STRIDE];
+shared uint Bs[LOCAL_SIZE_X * TILE_STRIDE];
+
+void main() {
+    uint lx = gl_LocalInvocationID.x;
+    uint ly = gl_LocalInvocationID.y;
+    uint lid = ly * LOCAL_SIZE_X + lx;
+    uint threads = LOCAL_SIZE_X * LOCAL_SIZE_Y;
+
+    uint rowBase = gl_WorkGroupID.y * LOCAL_SIZE_Y;
+    uint colBase = gl_WorkGroupID.x * LOCAL_SIZE_X;
+    uint row = rowBase + ly;
+    uint col = colBase + lx;
+
+    uint lastKw   = pc.K_words - 1u;
+    uint tailBits = pc.K_bits & 31u;
+    uint tailMask = (tailBits == 0u)
+        ? 0xFFFFFFFFu
+        : ((1u << tailBits) - 1u);
+
+    uint matches = 0u;
+
+    // Every invocation takes part in the loads and barriers, out-of-range rows and columns only skip the store
+    for (uint k0 = 0u; k0 < pc.K_words; k0 += K_TILE) {
+        // Consecutive invocations load consecutive words of a row, so the global reads coalesce.
+        // Padding is A = 0, B = ~0: their XNOR is 0 and adds no matches, which also masks the tail word.
+        for (uint i = lid; i < LOCAL_SIZE_Y * K_TILE; i += threads) {
+            uint r  = i / K_TILE;
+            uint kk = i % K_TILE;
+            uint kw = k0 + kk;
+            uint gr = rowBase + r;
+            uint a = 0u;
+            if (gr < pc.M && kw < pc.K_words) {
+                a = A_bits[gr * pc.K_words + kw];
+                if (kw == lastKw) a &= tailMask;
+            }
+            As[r * TILE_STRIDE + kk] = a;
+        }
+        for (uint i = lid; i < LOCAL_SIZE_X * K_TILE; i += threads) {
+            uint c  = i / K_TILE;
+            uint kk = i % K_TILE;
+            uint kw = k0 + kk;
+            uint gc = colBase + c;
+            uint b = 0xFFFFFFFFu;
+            if (gc < pc.N && kw < pc.K_words) {
+                b = B_bits[gc * pc.K_words + kw];
+                if (kw == lastKw) b |= ~tailMask;
+            }
+            Bs[c * TILE_STRIDE + kk] = b;
+        }
+        barrier();
+
+        uint aBase = ly * TILE_STRIDE;
+        uint bBase = lx * TILE_STRIDE;
+        for (uint kk = 0u; kk < K_TILE; ++kk) {
+            matches += bitCount(~(As[aBase + kk] ^ Bs[bBase + kk]));
+        }
+        barrier();
+    }
+
+    if (row >= pc.M || col >= pc.N)
+        return;
+
+    // Degenerate K gives 0, like binmatmul.comp.glsl
+    int dot = (pc.K_words == 0u) ? 0 : int(matches) * 2 - int(pc.K_bits);
+    C_out[row * pc.N + col] = dot;
+}
@@ -0,0 +1,24 @@
+#version 450
+#extension GL_EXT_buffer_reference : require
+
+layout(constant_id = 0) const uint LOCAL_SIZE_X = 64;
+layout(constant_id = 1) const uint LOCAL_SIZE_Y = 1;
+layout(constant_id = 2) const uint LOCAL_SIZE_Z = 1;
+layout(local_size_x_id = 0, local_size_y_id = 1, local_size_z_id = 2) in;
+
+layout(buffer_reference, std430, buffer_reference_align = 4) writeonly buffer DataBuf {
+    float data[];
+};
+
+layout(push_constant) uniform PC {
+    DataBuf buf;
+    float value;
+    uint  count;
+} pc;
+
+void main() {
+    uint i = gl_GlobalInvocationID.x;
+    if (i < pc.count) {
+        pc.buf.data[i] = pc.value;
+    }
+}
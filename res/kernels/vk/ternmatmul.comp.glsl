@@ -0,0 +1,44 @@
+#version 450
+
+layout(constant_id = 0) const uint LOCAL_SIZE_X = 8;
+layout(constant_id = 1) const uint LOCAL_SIZE_Y = 8;
+layout(constant_id = 2) const uint LOCAL_SIZE_Z = 1;
+layout(local_size_x_id = 0, local_size_y_id = 1, local_size_z_id = 2) in;
+
+// Two-bit-plane ternary operands, one (sign, nonzero) pair per 32 weights of K:
+//   A: [M x K_words] pairs, row-major
+//   B: [N x K_words] pairs, each original column of B becomes one row
+layout(set = 0, binding = 0) readonly buffer A_buf { uvec2 A_planes[]; };
+layout(set = 0, binding = 1) readonly buffer B_buf { uvec2 B_planes[]; };
+layout(set = 0, binding = 2) writeonly buffer C_buf { int C_out[]; };
+
+layout(push_constant) uniform PushConsts {
+    uint M;
+    uint N;
+    uint K_bits;
+    uint K_words;
+} pc;
+
+void main() {
+    uint row = gl_GlobalInvocationID.y;
+    uint col = gl_GlobalInvocationID.x;
+
+    if (row >= pc.M || col >= pc.N)
+        return;
+
+    uint baseA = row * pc.K_words;
+    uint baseB = col * pc.K_words;
+
+    // Bits past K_bits are zero in the nonzero plane, so the tail needs no mask
+    int dot = 0;
+    for (uint kw = 0u; kw < pc.K_words; ++kw) {
+        uvec2 a = A_planes[baseA + kw];
+        uvec2 b = B_planes[baseB + kw];
+
+        uint nz   = a.y & b.y;
+        uint diff = a.x ^ b.x;
+        dot += bitCount(nz & ~diff) - bitCount(nz & diff);
+    }
+
+    C_out[row * pc.N + col] = dot;
+}
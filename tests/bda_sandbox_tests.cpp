@@ -0,0 +1,108 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <tether_io/sanbox.hpp>
+
+using namespace tether_io;
+
+// Buffer-device-address kernels against their descriptor counterparts: binmatmul_bda against the CPU reference
+// the binmatmul sandbox checks the descriptor kernels with, fill_bda / multiply_bda against fill / multiply,
+// at offset 0 and inside the buffer. Skipped on devices without bufferDeviceAddress.
+
+namespace {
+
+enum class case_outcome { passed, failed, skipped };
+
+template<typename Result>
+auto report(const std::string& case_label, const std::expected<Result, device_error>& result, usize expected_total) -> case_outcome {
+    if (!result.has_value()) {
+        if (result.error() == device_error::not_available) {
+            std::cout << "[bda] " << case_label << " skipped: no bufferDeviceAddress\n";
+            return case_outcome::skipped;
+        }
+        std::cerr << "[bda] " << case_label << " failed: " << result.error() << "\n";
+        return case_outcome::failed;
+    }
+
+    const auto metrics = result.value();
+    if (metrics.total_size != expected_total) {
+        std::cerr << "[bda] " << case_label
+                  << " unexpected total_size=" << metrics.total_size
+                  << " (expected " << expected_total << ")\n";
+        return case_outcome::failed;
+    }
+
+    if (metrics.mismatches != 0) {
+        std::cerr << "[bda] " << case_label
+                  << " mismatches=" << metrics.mismatches
+                  << " max_abs_err=" << metrics.max_abs_err << "\n";
+        return case_outcome::failed;
+    }
+
+    std::cout << "[bda] " << case_label << " ok (total=" << metrics.total_size << ")" << std::endl;
+    return case_outcome::passed;
+}
+
+auto execute_binmatmul_case(data_domain domain, u32 M, u32 N, u32 K_bits) -> case_outcome {
+    const std::string case_label = "binmatmul_bda_" + to_string(domain) + "_" +
+                                   std::to_string(M) + "x" + std::to_string(N) + "_" +
+                                   std::to_string(K_bits) + "bit";
+
+    sandbox<sandbox_algorithm::binmatmul, device_driver::vulkan_native> bench;
+    return report(case_label, bench.run(domain, M, N, K_bits, "binmatmul_bda"), static_cast<usize>(M) * N);
+}
+
+auto execute_fill_case(u32 count, usize offset_bytes) -> case_outcome {
+    const std::string case_label = "fill_bda_" + std::to_string(count) + "+" + std::to_string(offset_bytes) + "B";
+
+    sandbox<sandbox_algorithm::fill, device_driver::vulkan_native> bench;
+    return report(case_label, bench.run(count, 3.25f, offset_bytes), count);
+}
+
+auto execute_mull_case(u32 count, usize offset_bytes) -> case_outcome {
+    const std::string case_label = "multiply_bda_" + std::to_string(count) + "+" + std::to_string(offset_bytes) + "B";
+
+    sandbox<sandbox_algorithm::mull, device_driver::vulkan_native> bench;
+    return report(case_label, bench.run(count, -1.5f, offset_bytes), count);
+}
+
+} // namespace
+
+auto main() -> int {
+    usize passed = 0;
+    usize failed = 0;
+    usize skipped = 0;
+
+    auto tally = [&](case_outcome outcome) {
+        if (outcome == case_outcome::passed) ++passed;
+        if (outcome == case_outcome::failed) ++failed;
+        if (outcome == case_outcome::skipped) ++skipped;
+    };
+
+    // Decode rows, square tiles and ragged edges, K with and without a partial last word
+    for (auto domain : {data_domain::pm_one, data_domain::zero_one}) {
+        for (auto [M, N] : {std::pair{1u, 509u}, std::pair{16u, 16u}, std::pair{37u, 53u}}) {
+            for (auto K_bits : {32u, 257u, 1024u}) {
+                tally(execute_binmatmul_case(domain, M, N, K_bits));
+            }
+        }
+    }
+
+    // Offsets of zero, one element, a ragged element count and all but the last element
+    for (u32 count : {64u, 1000u, 4096u}) {
+        for (usize offset_bytes : {usize{0}, sizeof(f32), usize{37} * sizeof(f32), (count - 1u) * sizeof(f32)}) {
+            tally(execute_fill_case(count, offset_bytes));
+            tally(execute_mull_case(count, offset_bytes));
+        }
+    }
+
+    if (failed == 0) {
+        std::cout << "[bda] completed " << passed << " cases without error, " << skipped << " skipped\n";
+    } else {
+        std::cerr << "[bda] " << failed << " of " << passed + failed + skipped << " cases failed\n";
+    }
+
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
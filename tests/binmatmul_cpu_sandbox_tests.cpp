@@ -0,0 +1,15 @@
+#include <array>
+#include <cstdlib>
+
+#include <tether_io/sanbox.hpp>
+
+using namespace tether_io;
+
+auto main() -> int {
+    // Short K hits only the masked tail word, the long ones cover the full SIMD bodies,
+    // the Harley-Seal blocks (>= 4096 bits) and every remainder path in between.
+    constexpr std::array<u32, 10> k_bit_values{1u, 16u, 32u, 48u, 64u, 257u, 511u, 1024u, 4096u, 8233u};
+    constexpr std::array<u32, 5> m_values{1u, 7u, 16u, 33u, 64u};
+
+    return run_cpu_sandbox_sweep<sandbox_algorithm::binmatmul>(m_values, k_bit_values) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
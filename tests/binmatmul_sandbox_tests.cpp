@@ -2,6 +2,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <utility>
 
 #include <tether_io/sanbox.hpp>
 
@@ -9,17 +10,19 @@ using namespace tether_io;
 
 namespace {
 
-auto make_case_label(data_domain domain, u32 M, u32 N, u32 K_bits) -> std::string {
-    return to_string(domain) + "_" +
+auto make_case_label(data_domain domain, u32 M, u32 N, u32 K_bits, const std::string& kernel) -> std::string {
+    return (kernel.empty() ? std::string{} : kernel + "_") +
+           to_string(domain) + "_" +
            std::to_string(M) + "x" + std::to_string(N) + "_" +
            std::to_string(K_bits) + "bit";
 }
 
-auto execute_case(data_domain domain, u32 M, u32 N, u32 K_bits) -> bool {
-    const std::string case_label = make_case_label(domain, M, N, K_bits);
+// `kernel` forces the "binmatmul" variant, empty keeps the one index.json selects
+auto execute_case(data_domain domain, u32 M, u32 N, u32 K_bits, const std::string& kernel = {}) -> bool {
+    const std::string case_label = make_case_label(domain, M, N, K_bits, kernel);
 
     sandbox<sandbox_algorithm::binmatmul, device_driver::vulkan_native> bench;
-    auto result = bench.run(domain, M, N, K_bits);
+    auto result = bench.run(domain, M, N, K_bits, kernel);
     if (!result.has_value()) {
         std::cerr << "[binmatmul] " << case_label
                   << " failed: " << result.error() << "\n";
@@ -83,6 +86,66 @@ auto main() -> int {
             }
         }
 
+        // Decode shapes take the GEMV kernel at every K, the subgroup kernel only starts past binmatmul_gemv_max_rows:
+        // a few rows against a wide, ragged N and K long enough for the lanes of a dot product to stride and for
+        // the shared-memory reduction to matter
+        for (u32 M = 1u; M <= binmatmul_gemv_max_rows; ++M) {
+            const u32 N = 509u;
+
+            for (auto K_bits : {16u, 257u, 4096u, 8233u}) {
+                domain_cases++;
+                total_cases++;
+
+                const bool ok = execute_case(domain, M, N, K_bits);
+                domain_passed = ok && domain_passed;
+                all_passed = ok && all_passed;
+            }
+        }
+
+        // Long K with few elements of C past the GEMV rows: the subgroup kernel on devices with subgroup
+        // arithmetic, with ragged N so the last workgroup has idle subgroups
+        for (u32 M : {5u, 24u}) {
+            const u32 N = 37u;
+
+            for (auto K_bits : {binmatmul_subgroup_min_k_bits, 8233u}) {
+                domain_cases++;
+                total_cases++;
+
+                const bool ok = execute_case(domain, M, N, K_bits);
+                domain_passed = ok && domain_passed;
+                all_passed = ok && all_passed;
+            }
+        }
+
+        // Every 2D variant forced through config.variants, whatever index.json selects: square and ragged
+        // shapes past the GEMV rows, K with and without a partial last word and longer than one K tile
+        for (const std::string kernel : {"binmatmul", "binmatmul_tiled", "binmatmul_microtile"}) {
+            for (auto [M, N] : {std::pair{16u, 16u}, std::pair{37u, 53u}, std::pair{130u, 7u}}) {
+                for (auto K_bits : {32u, 257u, 1100u}) {
+                    domain_cases++;
+                    total_cases++;
+
+                    const bool ok = execute_case(domain, M, N, K_bits, kernel);
+                    domain_passed = ok && domain_passed;
+                    all_passed = ok && all_passed;
+                }
+            }
+        }
+
+        // binmatmul_microtile: K_words % 4 == 0 takes the uvec4 loads (128, 250, 2040, 2048 bits), anything else the
+        // scalar ones (96, 70, 160, 1100 bits), both with and without a partial last word. M and N off the 4 x 4
+        // tile leave clamped rows and columns in the last invocations.
+        for (auto [M, N] : {std::pair{8u, 8u}, std::pair{13u, 22u}, std::pair{61u, 7u}}) {
+            for (auto K_bits : {128u, 250u, 2040u, 2048u, 96u, 70u, 160u, 1100u}) {
+                domain_cases++;
+                total_cases++;
+
+                const bool ok = execute_case(domain, M, N, K_bits, "binmatmul_microtile");
+                domain_passed = ok && domain_passed;
+                all_passed = ok && all_passed;
+            }
+        }
+
         if (domain_passed) {
             std::cout << "[binmatmul] domain=" << to_string(domain)
                       << " all cases passed (" << domain_cases << ")\n";
@@ -0,0 +1,93 @@
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include <tether_io/context/buddy_allocator.hpp>
+
+using namespace tether_io;
+
+// The pool behind alloc_method::custom sub-allocates device memory blocks with buddy_allocator. Random
+// allocate/free traffic must never hand out overlapping or misaligned ranges, the accounting has to follow
+// every call, and freeing everything has to merge the block back into one piece.
+auto main() -> int {
+    constexpr usize capacity  = usize(1) << 20;
+    constexpr usize min_block = 256;
+
+    buddy_allocator pool(capacity, min_block);
+    usize failures = 0;
+
+    struct live { usize size; usize alignment; };
+    std::map<usize, live> allocations; // offset -> request
+
+    u64 state = 0x9E3779B97F4A7C15ull;
+    auto next = [&] {
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        return state;
+    };
+
+    for (u32 step = 0; step < 20000; ++step) {
+        const bool do_free = !allocations.empty() && (next() % 3 == 0);
+        if (do_free) {
+            auto it = allocations.begin();
+            std::advance(it, next() % allocations.size());
+            if (!pool.free(it->first)) {
+                std::cerr << "[buddy_allocator] free of a live offset failed\n";
+                ++failures;
+            }
+            allocations.erase(it);
+        } else {
+            const usize size = 1 + next() % (capacity / 16);
+            const usize alignment = usize(1) << (next() % 13);
+            auto offset = pool.allocate(size, alignment);
+            if (!offset.has_value()) continue; // full, which is fine
+
+            const usize o = offset.value();
+            if (o % alignment != 0 || o + size > capacity) {
+                std::cerr << "[buddy_allocator] offset " << o << " misaligned or out of range\n";
+                ++failures;
+            }
+
+            // Neighbours in offset order must not overlap the new range
+            auto after = allocations.lower_bound(o);
+            if (after != allocations.end() && after->first < o + size) ++failures;
+            if (after != allocations.begin() && std::prev(after)->first + std::prev(after)->second.size > o) ++failures;
+
+            allocations.emplace(o, live{ size, alignment });
+        }
+
+        usize requested = 0;
+        for (const auto& [o, a] : allocations) requested += a.size;
+        if (pool.allocation_count() != allocations.size() || pool.requested() != requested || pool.used() < requested) {
+            std::cerr << "[buddy_allocator] accounting drifted at step " << step << "\n";
+            ++failures;
+            break;
+        }
+    }
+
+    if (pool.free(capacity + 1) || pool.allocate(capacity + 1).has_value() || pool.allocate(0).has_value()) {
+        std::cerr << "[buddy_allocator] invalid requests were accepted\n";
+        ++failures;
+    }
+
+    for (const auto& [o, a] : allocations) pool.free(o);
+    if (!pool.empty() || pool.used() != 0 || pool.largest_free_block() != capacity) {
+        std::cerr << "[buddy_allocator] freed blocks did not merge back into the full range\n";
+        ++failures;
+    }
+
+    // A full-size request succeeds exactly once after merging
+    if (!pool.allocate(capacity).has_value() || pool.allocate(min_block).has_value()) {
+        std::cerr << "[buddy_allocator] full-range allocation behaved unexpectedly\n";
+        ++failures;
+    }
+
+    if (failures != 0) {
+        std::cerr << "[buddy_allocator] " << failures << " failures\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "[buddy_allocator] random traffic stayed disjoint and aligned, blocks merged back\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <tether_io/algorithm.hpp>
+
+using namespace tether_io;
+
+// Every global allocation goes through these replacements, the test fails if the steady-state
+// loop below touches the heap at all.
+namespace {
+std::atomic<usize> allocation_count{0};
+}
+
+auto operator new(std::size_t size) -> void* {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc{};
+}
+
+auto operator new[](std::size_t size) -> void* { return ::operator new(size); }
+
+auto operator new(std::size_t size, std::align_val_t align) -> void* {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t alignment = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) return p;
+    throw std::bad_alloc{};
+}
+
+auto operator new[](std::size_t size, std::align_val_t align) -> void* { return ::operator new(size, align); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+// One "layer": pack activations and weights, then run every CPU GEMM entry point into reused outputs
+auto run_layer(
+    algorithm<device_driver::cpu_native, execution_method::standalone>& cpu,
+    const std::vector<f32>& A, const std::vector<f32>& B,
+    std::vector<u32>& A_bits, std::vector<u32>& B_bits,
+    std::vector<u32>& A_planes, std::vector<u32>& B_planes,
+    std::vector<i32>& C,
+    u32 M, u32 N, u32 K_bits
+) -> bool {
+    bool ok = true;
+    ok = cpu.f32_mat_to_packed_u32(matrix_order::row_major, A, A_bits, M, K_bits).has_value() && ok;
+    ok = cpu.f32_mat_to_packed_u32(matrix_order::col_major, B, B_bits, N, K_bits).has_value() && ok;
+    ok = cpu.binmatmul(A_bits, B_bits, C, M, N, K_bits).has_value() && ok;
+    ok = cpu.binmatmul_blocked(A_bits, B_bits, C, M, N, K_bits, cpu_gemm_blocking{16u, 32u, 4u}).has_value() && ok;
+    ok = cpu.binmatmul_parallel(A_bits, B_bits, C, M, N, K_bits, vec2<u32>{16u, 8u}).has_value() && ok;
+    ok = cpu.binmatmul_gemv(A_bits, B_bits, C, M, N, K_bits).has_value() && ok;
+    ok = cpu.f32_mat_to_packed_ternary_u32(matrix_order::row_major, A, A_planes, M, K_bits).has_value() && ok;
+    ok = cpu.f32_mat_to_packed_ternary_u32(matrix_order::col_major, B, B_planes, N, K_bits).has_value() && ok;
+    ok = cpu.ternmatmul(A_planes, B_planes, C, M, N, K_bits).has_value() && ok;
+    return ok;
+}
+
+} // namespace
+
+auto main() -> int {
+    constexpr u32 M = 37u;
+    constexpr u32 N = 53u;
+    constexpr u32 K_bits = 1000u;
+    constexpr u32 K_words = (K_bits + 31u) / 32u;
+    constexpr int iterations = 16;
+
+    algorithm<device_driver::cpu_native, execution_method::standalone> cpu;
+    cpu.set_thread_count(3);
+
+    // All buffers are sized once up front, exactly like a serving loop would keep them per layer
+    std::vector<f32> A(static_cast<usize>(M) * K_bits);
+    std::vector<f32> B(static_cast<usize>(K_bits) * N);
+    std::vector<u32> A_bits(static_cast<usize>(M) * K_words);
+    std::vector<u32> B_bits(static_cast<usize>(N) * K_words);
+    std::vector<u32> A_planes(static_cast<usize>(M) * K_words * 2u);
+    std::vector<u32> B_planes(static_cast<usize>(N) * K_words * 2u);
+    std::vector<i32> C(static_cast<usize>(M) * N);
+
+    if (!cpu.random_mat_binary_f32_1d(data_domain::trinary, A, M, K_bits, 7937929).has_value() ||
+        !cpu.random_mat_binary_f32_1d(data_domain::trinary, B, K_bits, N, 732973980).has_value()) {
+        std::cerr << "[cpu_allocation] could not generate inputs\n";
+        return EXIT_FAILURE;
+    }
+
+    // Warm-up: spawns the pool workers, grows the blocked workspace and caches the CPU feature probe
+    if (!run_layer(cpu, A, B, A_bits, B_bits, A_planes, B_planes, C, M, N, K_bits)) {
+        std::cerr << "[cpu_allocation] warm-up call failed\n";
+        return EXIT_FAILURE;
+    }
+
+    const usize before = allocation_count.load();
+    bool ok = true;
+    for (int i = 0; i < iterations; ++i) {
+        ok = run_layer(cpu, A, B, A_bits, B_bits, A_planes, B_planes, C, M, N, K_bits) && ok;
+    }
+    const usize allocations = allocation_count.load() - before;
+
+    if (!ok) {
+        std::cerr << "[cpu_allocation] a span overload returned an error\n";
+        return EXIT_FAILURE;
+    }
+
+    if (allocations != 0) {
+        std::cerr << "[cpu_allocation] " << allocations << " heap allocations over "
+                  << iterations << " steady-state layers (expected 0)\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "[cpu_allocation] " << iterations << " steady-state layers without heap allocations\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,114 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <tether_io/algorithm.hpp>
+
+using namespace tether_io;
+
+namespace {
+
+auto in_domain(data_domain domain, f32 v) -> bool {
+    switch (domain) {
+        case data_domain::pm_one:     return v == -1.0f || v == 1.0f;
+        case data_domain::zero_one:   return v >= 0.0f && v < 1.0f;
+        case data_domain::full_range: return v >= -1e6f && v < 1e6f;
+        case data_domain::trinary:    return v == -1.0f || v == 0.0f || v == 1.0f;
+        default:                      return false;
+    }
+}
+
+} // namespace
+
+// The generator is counter based: a seed has to give bit-identical matrices for every thread count and
+// every instruction set, different seeds have to differ and every value has to stay inside its domain. The packed generators
+// have to match packing the f32 matrix of the same seed.
+auto main() -> int {
+    constexpr u32 rows = 523u;   // rows * cols spans several parallel chunks and ends on a partial one
+    constexpr u32 cols = 389u;
+    constexpr u32 seed = 7937929u;
+
+    const data_domain domains[] = { data_domain::pm_one, data_domain::zero_one, data_domain::full_range, data_domain::trinary };
+    const usize thread_counts[] = { 1u, 2u, 3u, 8u };
+
+    usize failures = 0;
+    for (auto domain : domains) {
+        algorithm<device_driver::cpu_native, execution_method::standalone> cpu;
+        cpu.set_thread_count(1);
+
+        // The scalar fill is the reference, the SIMD fills have to produce the same bits
+        std::vector<f32> ref(static_cast<usize>(rows) * cols);
+        auto reference = cpu.random_mat_binary_f32_1d(domain, ref, rows, cols, seed, cpu_isa::scalar);
+        if (!reference.has_value()) {
+            std::cerr << "[random_mat] " << to_string(domain) << " generation failed\n";
+            ++failures;
+            continue;
+        }
+
+        for (auto isa : { cpu_isa::avx2, cpu_isa::avx512_vpopcntdq, cpu_isa::neon }) {
+            if (!is_cpu_isa_supported(isa)) continue;
+            std::vector<f32> out(ref.size());
+            if (!cpu.random_mat_binary_f32_1d(domain, out, rows, cols, seed, isa).has_value() ||
+                std::memcmp(out.data(), ref.data(), ref.size() * sizeof(f32)) != 0) {
+                std::cerr << "[random_mat] " << to_string(domain) << " " << to_string(isa) << " differs from scalar\n";
+                ++failures;
+            }
+        }
+
+        for (f32 v : ref) {
+            if (!in_domain(domain, v)) {
+                std::cerr << "[random_mat] " << to_string(domain) << " value " << v << " outside its domain\n";
+                ++failures;
+                break;
+            }
+        }
+
+        for (usize threads : thread_counts) {
+            cpu.set_thread_count(threads);
+            std::vector<f32> out(ref.size());
+            if (!cpu.random_mat_binary_f32_1d(domain, out, rows, cols, seed).has_value() ||
+                std::memcmp(out.data(), ref.data(), ref.size() * sizeof(f32)) != 0) {
+                std::cerr << "[random_mat] " << to_string(domain) << " differs with " << threads << " threads\n";
+                ++failures;
+            }
+        }
+
+        // The packed generators have to reproduce the packers applied to the f32 matrix, ref read as
+        // [rows x cols] is the row-major A side and as [k_bits = rows x matrix_side = cols] the column-major B side
+        struct packed_case { const char* name; matrix_order order; bool ternary; u32 matrix_side; u32 k_bits; };
+        const packed_case packed_cases[] = {
+            { "binary row_major",  matrix_order::row_major, false, rows, cols },
+            { "binary col_major",  matrix_order::col_major, false, cols, rows },
+            { "ternary row_major", matrix_order::row_major, true,  rows, cols },
+            { "ternary col_major", matrix_order::col_major, true,  cols, rows },
+        };
+        for (const auto& pc : packed_cases) {
+            auto expected = pc.ternary
+                ? cpu.f32_mat_to_packed_ternary_u32(pc.order, ref, pc.matrix_side, pc.k_bits)
+                : cpu.f32_mat_to_packed_u32(pc.order, ref, pc.matrix_side, pc.k_bits);
+            auto packed = pc.ternary
+                ? cpu.random_mat_packed_ternary_u32(domain, pc.order, pc.matrix_side, pc.k_bits, seed)
+                : cpu.random_mat_packed_u32(domain, pc.order, pc.matrix_side, pc.k_bits, seed);
+            if (!expected.has_value() || !packed.has_value() || expected.value() != packed.value()) {
+                std::cerr << "[random_mat] " << to_string(domain) << " packed " << pc.name << " differs from packing the f32 matrix\n";
+                ++failures;
+            }
+        }
+
+        auto other = cpu.random_mat_binary_f32_1d(domain, rows, cols, seed + 1u);
+        if (!other.has_value() || std::memcmp(other.value().data(), ref.data(), ref.size() * sizeof(f32)) == 0) {
+            std::cerr << "[random_mat] " << to_string(domain) << " ignores the seed\n";
+            ++failures;
+        }
+    }
+
+    if (failures != 0) {
+        std::cerr << "[random_mat] " << failures << " failures\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "[random_mat] all domains reproducible across thread counts and instruction sets, packed generators match the packers\n";
+    return EXIT_SUCCESS;
+}